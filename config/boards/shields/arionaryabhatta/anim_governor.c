@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+#include <zmk/activity.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+
+#include "anim_governor.h"
+
+static sys_slist_t clients = SYS_SLIST_STATIC_INIT(&clients);
+
+static bool paused;
+static enum zmk_activity_state activity_state = ZMK_ACTIVITY_ACTIVE;
+
+#if IS_ENABLED(CONFIG_ARIXA_ANIM_GOVERNOR_WAKEUPS)
+// display work queue wakeups and uptime at the last pause or resume
+static uint32_t window_wakeups;
+static int64_t window_start;
+
+// every switch to the thread is counted by the scheduler's usage analysis, ZMK's display tick
+// alone wakes it 100 times a second while its timer runs
+static uint32_t display_wakeups() { return zmk_display_work_q()->thread.base.usage.num_windows; }
+
+static void start_window() {
+    window_wakeups = display_wakeups();
+    window_start = k_uptime_get();
+}
+#endif
+
+static void governor_work_cb(struct k_work *work) {
+    bool idle = activity_state != ZMK_ACTIVITY_ACTIVE;
+    lv_disp_t *disp = lv_disp_get_default();
+    struct zmk_anim_governor_client *client;
+
+    if (idle == paused) {
+        return;
+    }
+
+#if IS_ENABLED(CONFIG_ARIXA_ANIM_GOVERNOR_WAKEUPS)
+    LOG_INF("display work queue woke %u times/s while animations were %s",
+            zmk_anim_governor_wakeups_per_sec(), paused ? "paused" : "running");
+    start_window();
+#endif
+    paused = idle;
+
+    if (paused) {
+        SYS_SLIST_FOR_EACH_CONTAINER(&clients, client, node) { client->pause(); }
+
+        // draw the resting frames before the refresh timer stops
+        lv_refr_now(disp);
+        lv_timer_pause(disp->refr_timer);
+    } else {
+        lv_timer_resume(disp->refr_timer);
+
+        SYS_SLIST_FOR_EACH_CONTAINER(&clients, client, node) { client->resume(); }
+    }
+}
+
+static K_WORK_DEFINE(governor_work, governor_work_cb);
+
+static int anim_governor_listener(const zmk_event_t *eh) {
+    const struct zmk_activity_state_changed *ev = as_zmk_activity_state_changed(eh);
+
+    if (ev == NULL) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    activity_state = ev->state;
+    if (zmk_display_is_initialized()) {
+        k_work_submit_to_queue(zmk_display_work_q(), &governor_work);
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(anim_governor, anim_governor_listener);
+ZMK_SUBSCRIPTION(anim_governor, zmk_activity_state_changed);
+
+void zmk_anim_governor_register(struct zmk_anim_governor_client *client) {
+    sys_slist_append(&clients, &client->node);
+}
+
+bool zmk_anim_governor_is_paused() { return paused; }
+
+void zmk_anim_governor_start(lv_anim_t *a) {
+    if (paused) {
+        lv_anim_del(a->var, a->exec_cb);
+        a->exec_cb(a->var, a->end_value);
+        return;
+    }
+
+    lv_anim_start(a);
+}
+
+int zmk_anim_governor_init() {
+    if (lv_disp_get_default() == NULL) {
+        return -ENODEV;
+    }
+
+#if IS_ENABLED(CONFIG_ARIXA_ANIM_GOVERNOR_WAKEUPS)
+    start_window();
+#endif
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_ARIXA_ANIM_GOVERNOR_WAKEUPS)
+uint32_t zmk_anim_governor_wakeups_per_sec() {
+    int64_t elapsed = k_uptime_get() - window_start;
+
+    return elapsed > 0 ? (uint64_t)(display_wakeups() - window_wakeups) * 1000 / elapsed : 0;
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+static int cmd_wakeups(const struct shell *sh, size_t argc, char **argv) {
+    shell_print(sh, "display work queue: %u wakeups/s since animations %s",
+                zmk_anim_governor_wakeups_per_sec(), paused ? "paused" : "resumed");
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((arixa), wakeups, NULL, "Display work queue wakeups per second", cmd_wakeups, 1,
+                 0);
+
+#endif
+#endif
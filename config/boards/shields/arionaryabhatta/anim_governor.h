@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+// Widgets with looping animations register to be paused while the pad is idle.
+struct zmk_anim_governor_client {
+    sys_snode_t node;
+    void (*pause)();
+    void (*resume)();
+};
+
+int zmk_anim_governor_init();
+void zmk_anim_governor_register(struct zmk_anim_governor_client *client);
+bool zmk_anim_governor_is_paused();
+
+// Starts a one-shot animation, or jumps straight to its end value while paused.
+void zmk_anim_governor_start(lv_anim_t *a);
+
+// Times per second the display work queue thread was switched in since animations were last
+// paused or resumed, with ARIXA_ANIM_GOVERNOR_WAKEUPS.
+uint32_t zmk_anim_governor_wakeups_per_sec();
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <zephyr/drivers/sensor.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+#include <zmk/activity.h>
+#include <zmk/usb.h>
+
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+#include <zmk/events/usb_conn_state_changed.h>
+#endif
+
+#include "battery_gauge.h"
+#include "events/battery_gauge_changed.h"
+
+static const struct device *const battery = DEVICE_DT_GET(DT_CHOSEN(zmk_battery));
+
+// Resting LiPo cell voltage against remaining charge, from full down to the protection cutoff.
+static const struct {
+    uint16_t millivolts;
+    uint8_t percent;
+} discharge_curve[] = {
+    {4200, 100}, {4150, 95}, {4110, 90}, {4080, 85}, {4020, 80}, {3980, 75}, {3950, 70},
+    {3910, 65},  {3870, 60}, {3850, 55}, {3840, 50}, {3820, 45}, {3800, 40}, {3790, 35},
+    {3770, 30},  {3750, 25}, {3730, 20}, {3710, 15}, {3690, 10}, {3610, 5},  {3270, 0},
+};
+
+// the voltage filter keeps 4 fraction bits and moves 1/2^FILTER_SHIFT of the way per sample
+#define FILTER_FRAC 4
+#define FILTER_SHIFT 2
+
+// drain is only measured over at least this much charge, in permille, so ADC noise averages out
+#define DRAIN_MIN_STEP 20
+
+static struct zmk_battery_gauge_state state;
+static uint32_t filtered_mv; // millivolts << FILTER_FRAC, 0 until the first sample
+
+static struct {
+    int64_t timestamp;
+    uint16_t permille;
+    bool valid;
+} drain_anchor;
+static uint32_t drain_rate; // permille per hour << 4, 0 until measured
+
+static uint16_t millivolts_to_permille(uint16_t mv) {
+    if (mv >= discharge_curve[0].millivolts) {
+        return 1000;
+    }
+
+    for (int i = 1; i < ARRAY_SIZE(discharge_curve); i++) {
+        uint16_t hi_mv = discharge_curve[i - 1].millivolts;
+        uint16_t lo_mv = discharge_curve[i].millivolts;
+
+        if (mv < lo_mv) {
+            continue;
+        }
+
+        uint32_t hi = discharge_curve[i - 1].percent * 10;
+        uint32_t lo = discharge_curve[i].percent * 10;
+
+        return lo + (hi - lo) * (mv - lo_mv) / (hi_mv - lo_mv);
+    }
+
+    return 0;
+}
+
+static void update_drain(uint16_t permille, int64_t now) {
+    if (state.charging) {
+        drain_anchor.valid = false;
+        return;
+    }
+
+    // a rising reading is load recovery, start measuring again from there
+    if (!drain_anchor.valid || permille > drain_anchor.permille) {
+        drain_anchor.timestamp = now;
+        drain_anchor.permille = permille;
+        drain_anchor.valid = true;
+        return;
+    }
+
+    if (drain_anchor.permille - permille < DRAIN_MIN_STEP) {
+        return;
+    }
+
+    int64_t elapsed_ms = MAX(now - drain_anchor.timestamp, 1);
+    uint32_t rate = (uint32_t)(((uint64_t)(drain_anchor.permille - permille) << 4) * 3600000 /
+                               elapsed_ms);
+
+    drain_rate = drain_rate == 0 ? rate : (drain_rate * 3 + rate) / 4;
+    drain_anchor.timestamp = now;
+    drain_anchor.permille = permille;
+}
+
+static uint16_t minutes_to_empty(uint16_t permille) {
+    if (state.charging || drain_rate == 0) {
+        return 0;
+    }
+
+    uint32_t minutes = MIN(((uint64_t)permille << 4) * 60 / drain_rate, UINT16_MAX);
+
+    // past two hours the estimate is only good to the hour, don't raise an event every sample
+    return minutes < 120 ? minutes : minutes - minutes % 60;
+}
+
+static int read_millivolts(uint16_t *mv) {
+    struct sensor_value value;
+    int rc = sensor_sample_fetch_chan(battery, SENSOR_CHAN_GAUGE_VOLTAGE);
+
+    if (rc == 0) {
+        rc = sensor_channel_get(battery, SENSOR_CHAN_GAUGE_VOLTAGE, &value);
+    }
+    if (rc != 0) {
+        return rc;
+    }
+
+    *mv = value.val1 * 1000 + value.val2 / 1000;
+    return 0;
+}
+
+static void sample(bool charging) {
+    struct zmk_battery_gauge_state next;
+    uint16_t mv;
+    int rc = read_millivolts(&mv);
+
+    if (rc != 0) {
+        LOG_WRN("battery voltage read failed: %d", rc);
+        return;
+    }
+
+    // charging lifts the cell voltage, so the filter starts over on every transition
+    if (filtered_mv == 0 || charging != state.charging) {
+        filtered_mv = mv << FILTER_FRAC;
+        drain_anchor.valid = false;
+    } else {
+        filtered_mv += (((int32_t)mv << FILTER_FRAC) - (int32_t)filtered_mv) >> FILTER_SHIFT;
+    }
+
+    next.millivolts = filtered_mv >> FILTER_FRAC;
+    next.charging = charging;
+
+    uint16_t permille = millivolts_to_permille(next.millivolts);
+    bool changed = state.millivolts == 0 || charging != state.charging;
+
+    state.charging = charging;
+    update_drain(permille, k_uptime_get());
+
+    next.state_of_charge = DIV_ROUND_CLOSEST(permille, 10);
+    next.minutes_to_empty = minutes_to_empty(permille);
+
+    changed |= next.state_of_charge != state.state_of_charge ||
+               next.minutes_to_empty != state.minutes_to_empty;
+
+    state = next;
+    LOG_DBG("battery %u mV, %u%%, %u min left%s", state.millivolts, state.state_of_charge,
+            state.minutes_to_empty, state.charging ? ", charging" : "");
+
+    if (changed) {
+        raise_zmk_battery_gauge_changed((struct zmk_battery_gauge_changed){.state = state});
+    }
+}
+
+static bool usb_powered() {
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+    return zmk_usb_is_powered();
+#else
+    return false;
+#endif
+}
+
+#define ACTIVE_INTERVAL K_SECONDS(CONFIG_ARIXA_BATTERY_GAUGE_ACTIVE_INTERVAL)
+#define IDLE_INTERVAL K_SECONDS(CONFIG_ARIXA_BATTERY_GAUGE_IDLE_INTERVAL)
+
+static void sample_work_cb(struct k_work *work) {
+    sample(usb_powered());
+
+    // nothing drains fast enough while asleep to be worth waking the ADC for
+    switch (zmk_activity_get_state()) {
+    case ZMK_ACTIVITY_ACTIVE:
+        k_work_schedule(k_work_delayable_from_work(work), ACTIVE_INTERVAL);
+        break;
+    case ZMK_ACTIVITY_IDLE:
+        k_work_schedule(k_work_delayable_from_work(work), IDLE_INTERVAL);
+        break;
+    default:
+        break;
+    }
+}
+
+static K_WORK_DELAYABLE_DEFINE(sample_work, sample_work_cb);
+
+struct zmk_battery_gauge_state zmk_battery_gauge_get_state() { return state; }
+
+static int battery_gauge_listener(const zmk_event_t *eh) {
+    const struct zmk_activity_state_changed *ev = as_zmk_activity_state_changed(eh);
+
+    if (ev == NULL) {
+        // plugging in or out changes the reading straight away, sample without waiting
+        k_work_reschedule(&sample_work, K_NO_WAIT);
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    switch (ev->state) {
+    case ZMK_ACTIVITY_ACTIVE:
+        // waking up brings the next sample forward to the active interval
+        if (!k_work_delayable_is_pending(&sample_work) ||
+            k_work_delayable_remaining_get(&sample_work) > ACTIVE_INTERVAL.ticks) {
+            k_work_reschedule(&sample_work, ACTIVE_INTERVAL);
+        }
+        break;
+    case ZMK_ACTIVITY_SLEEP:
+        k_work_cancel_delayable(&sample_work);
+        break;
+    default:
+        // the pending sample already runs at the active interval, the next one stretches out
+        break;
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(battery_gauge, battery_gauge_listener);
+ZMK_SUBSCRIPTION(battery_gauge, zmk_activity_state_changed);
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+ZMK_SUBSCRIPTION(battery_gauge, zmk_usb_conn_state_changed);
+#endif
+
+static int battery_gauge_init(void) {
+    if (!device_is_ready(battery)) {
+        LOG_ERR("battery sensor %s is not ready", battery->name);
+        return -ENODEV;
+    }
+
+    k_work_schedule(&sample_work, K_NO_WAIT);
+    return 0;
+}
+
+SYS_INIT(battery_gauge_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
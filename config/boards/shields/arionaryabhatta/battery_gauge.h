@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+struct zmk_battery_gauge_state {
+    uint16_t millivolts;       // filtered cell voltage, 0 before the first sample
+    uint8_t state_of_charge;   // percent, from the LiPo discharge curve
+    bool charging;             // USB powered, the cell voltage reads high while charging
+    uint16_t minutes_to_empty; // 0 while charging or until enough drain has been seen
+};
+
+struct zmk_battery_gauge_state zmk_battery_gauge_get_state();
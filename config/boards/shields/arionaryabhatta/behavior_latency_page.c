@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT arixa_behavior_latency_page
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <drivers/behavior.h>
+
+#include <zmk/behavior.h>
+
+#include "latency_page.h"
+
+static int latency_page_pressed(struct zmk_behavior_binding *binding,
+                                struct zmk_behavior_binding_event event) {
+    zmk_latency_page_toggle();
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static int latency_page_released(struct zmk_behavior_binding *binding,
+                                 struct zmk_behavior_binding_event event) {
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api latency_page_api = {
+    .binding_pressed = latency_page_pressed,
+    .binding_released = latency_page_released,
+};
+
+#define LATENCY_PAGE_INST(n)                                                                       \
+    BEHAVIOR_DT_INST_DEFINE(n, NULL, NULL, NULL, NULL, POST_KERNEL,                                \
+                            CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &latency_page_api);
+
+DT_INST_FOREACH_STATUS_OKAY(LATENCY_PAGE_INST)
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT arixa_behavior_sensor_accel
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <drivers/behavior.h>
+#include <stdlib.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/behavior.h>
+#include <zmk/behavior_queue.h>
+#include <zmk/keymap.h>
+#include <zmk/sensors.h>
+#include <zmk/virtual_key_position.h>
+
+// Sensor events and the drain work both run on the system work queue, so the sensor state needs
+// no lock. A consumer key like C_VOL_UP counts once per press, so every step still costs a press
+// and a release report; what goes away is the burst, and steps undone by a turn back.
+
+struct accel_sensor {
+    const struct device *dev;
+    struct k_work_delayable drain_work;
+    struct zmk_behavior_binding_event event; // of the last trigger, steps are sent with it
+    struct zmk_behavior_binding cw;
+    struct zmk_behavior_binding ccw;
+    int64_t last_ms;      // last trigger
+    int64_t next_step_ms; // earliest press of the next step
+    uint32_t velocity;    // detents per second, 0 for the first detent of a turn
+    uint32_t carry;       // step percents short of a whole step
+    int32_t pending;      // steps not sent yet, negative counter clockwise
+    int8_t direction;     // of the last trigger
+};
+
+struct accel_config {
+    const char *cw_dev;
+    const char *ccw_dev;
+    uint32_t tap_ms;
+    uint32_t step_interval_ms;
+    uint32_t idle_ms;
+    int32_t max_pending;
+    size_t points;
+    const uint16_t *velocities;
+    const uint16_t *step_percents;
+};
+
+struct accel_data {
+    struct sensor_value remainder[ZMK_KEYMAP_SENSORS_LEN][ZMK_KEYMAP_LAYERS_LEN];
+    int triggers[ZMK_KEYMAP_SENSORS_LEN][ZMK_KEYMAP_LAYERS_LEN];
+    struct accel_sensor sensors[ZMK_KEYMAP_SENSORS_LEN];
+};
+
+// steps per detent in percent, linear between the curve points and flat past either end
+static uint32_t step_percent(const struct accel_config *cfg, uint32_t velocity) {
+    if (velocity <= cfg->velocities[0]) {
+        return cfg->step_percents[0];
+    }
+
+    for (int i = 1; i < cfg->points; i++) {
+        uint32_t v0 = cfg->velocities[i - 1], v1 = cfg->velocities[i];
+        int32_t p0 = cfg->step_percents[i - 1], p1 = cfg->step_percents[i];
+
+        if (velocity < v1) {
+            return p0 + (p1 - p0) * (int32_t)(velocity - v0) / (int32_t)(v1 - v0);
+        }
+    }
+
+    return cfg->step_percents[cfg->points - 1];
+}
+
+static void drain_work_cb(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct accel_sensor *sensor = CONTAINER_OF(dwork, struct accel_sensor, drain_work);
+    const struct accel_config *cfg = sensor->dev->config;
+
+    if (sensor->pending == 0) {
+        return;
+    }
+
+    struct zmk_behavior_binding binding = sensor->pending > 0 ? sensor->cw : sensor->ccw;
+    sensor->pending += sensor->pending > 0 ? -1 : 1;
+    sensor->event.timestamp = k_uptime_get();
+    sensor->next_step_ms = sensor->event.timestamp + cfg->step_interval_ms;
+
+    zmk_behavior_queue_add(&sensor->event, binding, true, cfg->tap_ms);
+    zmk_behavior_queue_add(&sensor->event, binding, false, 0);
+
+    // at the absolute time, a relative delay is rounded up a tick and every interval runs long
+    if (sensor->pending != 0) {
+        k_work_schedule(dwork, K_TIMEOUT_ABS_MS(sensor->next_step_ms));
+    }
+}
+
+static int accel_accept_data(struct zmk_behavior_binding *binding,
+                             struct zmk_behavior_binding_event event,
+                             const struct zmk_sensor_config *sensor_config,
+                             size_t channel_data_size,
+                             const struct zmk_sensor_channel_data *channel_data) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct accel_data *data = dev->data;
+    int sensor_index = ZMK_SENSOR_POSITION_FROM_VIRTUAL_KEY_POSITION(event.position);
+    struct sensor_value *remainder = &data->remainder[sensor_index][event.layer];
+    const struct sensor_value value = channel_data[0].value;
+
+    // alps,ec11 without steps, as on the base shield, reports detents in val2 and no degrees
+    if (value.val1 == 0) {
+        data->triggers[sensor_index][event.layer] = value.val2;
+        return 0;
+    }
+
+    // degrees carried per layer as zmk,behavior-sensor-rotate does, every active layer sees them
+    int trigger_degrees = 360 / sensor_config->triggers_per_rotation;
+
+    remainder->val1 += value.val1;
+    remainder->val2 += value.val2;
+    if (remainder->val2 >= 1000000 || remainder->val2 <= -1000000) {
+        remainder->val1 += remainder->val2 / 1000000;
+        remainder->val2 %= 1000000;
+    }
+
+    data->triggers[sensor_index][event.layer] = remainder->val1 / trigger_degrees;
+    remainder->val1 %= trigger_degrees;
+    return 0;
+}
+
+static int accel_process(struct zmk_behavior_binding *binding,
+                         struct zmk_behavior_binding_event event,
+                         enum behavior_sensor_binding_process_mode mode) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    const struct accel_config *cfg = dev->config;
+    struct accel_data *data = dev->data;
+    int sensor_index = ZMK_SENSOR_POSITION_FROM_VIRTUAL_KEY_POSITION(event.position);
+    int triggers = data->triggers[sensor_index][event.layer];
+    struct accel_sensor *sensor = &data->sensors[sensor_index];
+
+    data->triggers[sensor_index][event.layer] = 0;
+    if (mode != BEHAVIOR_SENSOR_BINDING_PROCESS_MODE_TRIGGER || triggers == 0) {
+        return ZMK_BEHAVIOR_TRANSPARENT;
+    }
+
+    int direction = triggers > 0 ? 1 : -1;
+    int64_t elapsed = event.timestamp - sensor->last_ms;
+
+    if (direction != sensor->direction || elapsed > cfg->idle_ms) {
+        sensor->velocity = 0;
+        sensor->carry = 0;
+    } else {
+        uint32_t velocity = abs(triggers) * 1000 / MAX(elapsed, 1);
+
+        // averaged so one slow detent in a spin does not drop back to the start of the curve
+        sensor->velocity = sensor->velocity == 0 ? velocity : (sensor->velocity + velocity) / 2;
+    }
+    sensor->direction = direction;
+    sensor->last_ms = event.timestamp;
+
+    uint32_t percent = step_percent(cfg, sensor->velocity);
+
+    // the curve is bounded by the rate the drain sends at, 1000 / step-interval-ms steps a second,
+    // so a fast spin does not ask for steps that would only wait and be dropped
+    if (sensor->velocity > 0) {
+        percent = MIN(percent, 100000 / (sensor->velocity * cfg->step_interval_ms));
+    }
+
+    uint32_t percents = abs(triggers) * percent + sensor->carry;
+    sensor->carry = percents % 100;
+    // only a burst faster than the velocity average has caught up with is left to reach the cap
+    sensor->pending = CLAMP(sensor->pending + direction * (int32_t)(percents / 100),
+                            -cfg->max_pending, cfg->max_pending);
+
+    sensor->event = event;
+    sensor->cw = (struct zmk_behavior_binding){.behavior_dev = cfg->cw_dev,
+                                               .param1 = binding->param1};
+    sensor->ccw = (struct zmk_behavior_binding){.behavior_dev = cfg->ccw_dev,
+                                                .param1 = binding->param2};
+
+    // an already scheduled drain keeps its time, steps never go out closer than the interval
+    k_work_schedule(&sensor->drain_work, sensor->next_step_ms <= k_uptime_get()
+                                             ? K_NO_WAIT
+                                             : K_TIMEOUT_ABS_MS(sensor->next_step_ms));
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api accel_api = {
+    .sensor_binding_accept_data = accel_accept_data,
+    .sensor_binding_process = accel_process,
+};
+
+static int accel_init(const struct device *dev) {
+    const struct accel_config *cfg = dev->config;
+    struct accel_data *data = dev->data;
+
+    for (int i = 1; i < cfg->points; i++) {
+        if (cfg->velocities[i] <= cfg->velocities[i - 1]) {
+            LOG_ERR("%s: velocities must ascend", dev->name);
+            return -EINVAL;
+        }
+    }
+
+    for (int i = 0; i < ZMK_KEYMAP_SENSORS_LEN; i++) {
+        data->sensors[i].dev = dev;
+        k_work_init_delayable(&data->sensors[i].drain_work, drain_work_cb);
+    }
+
+    return 0;
+}
+
+#define SENSOR_ACCEL_INST(n)                                                                       \
+    BUILD_ASSERT(DT_INST_PROP_LEN(n, bindings) == 2,                                               \
+                 "bindings needs a clockwise and a counter clockwise behavior");                   \
+    BUILD_ASSERT(DT_INST_PROP_LEN(n, velocities) == DT_INST_PROP_LEN(n, step_percents),            \
+                 "step-percents needs one entry per velocities point");                            \
+                                                                                                   \
+    static const uint16_t velocities_##n[] = DT_INST_PROP(n, velocities);                          \
+    static const uint16_t step_percents_##n[] = DT_INST_PROP(n, step_percents);                    \
+                                                                                                   \
+    static const struct accel_config accel_config_##n = {                                          \
+        .cw_dev = DEVICE_DT_NAME(DT_INST_PHANDLE_BY_IDX(n, bindings, 0)),                          \
+        .ccw_dev = DEVICE_DT_NAME(DT_INST_PHANDLE_BY_IDX(n, bindings, 1)),                         \
+        .tap_ms = DT_INST_PROP(n, tap_ms),                                                         \
+        .step_interval_ms = DT_INST_PROP(n, step_interval_ms),                                     \
+        .idle_ms = DT_INST_PROP(n, idle_ms),                                                       \
+        .max_pending = DT_INST_PROP(n, max_pending),                                               \
+        .points = ARRAY_SIZE(velocities_##n),                                                      \
+        .velocities = velocities_##n,                                                              \
+        .step_percents = step_percents_##n,                                                        \
+    };                                                                                             \
+                                                                                                   \
+    static struct accel_data accel_data_##n;                                                       \
+                                                                                                   \
+    BEHAVIOR_DT_INST_DEFINE(n, accel_init, NULL, &accel_data_##n, &accel_config_##n, POST_KERNEL,  \
+                            CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &accel_api);
+
+DT_INST_FOREACH_STATUS_OKAY(SENSOR_ACCEL_INST)
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+
+#include "compositor.h"
+#include "render_profile.h"
+#include "oled_theme.h"
+
+#define DISPLAY_NODE DT_CHOSEN(zephyr_display)
+#define PANEL_WIDTH DT_PROP(DISPLAY_NODE, width)
+#define PANEL_HEIGHT DT_PROP(DISPLAY_NODE, height)
+#define PANEL_PAGES (PANEL_HEIGHT / 8)
+
+BUILD_ASSERT(PANEL_HEIGHT % 8 == 0, "the framebuffer holds whole pages");
+
+static const struct device *display_dev = DEVICE_DT_GET(DISPLAY_NODE);
+
+static uint8_t framebuffer[PANEL_PAGES][PANEL_WIDTH];
+
+// columns of each page that differ from what was last written, none while x1 > x2
+static struct {
+    int16_t x1;
+    int16_t x2;
+} dirty[PANEL_PAGES];
+
+// panels that encode black as a clear bit get every written byte inverted
+static bool invert;
+static uint8_t inverted_row[PANEL_WIDTH];
+
+// set bits in the framebuffer, whichever way the bytes are sent
+static uint32_t set_pixels;
+
+LV_FONT_DECLARE(arixa_font_8);
+
+// matches the letter spacing of the LVGL status screen style
+#define LETTER_SPACE 1
+
+static void store(int page, int x, uint8_t value) {
+    if (framebuffer[page][x] == value) {
+        return;
+    }
+
+    set_pixels += POPCOUNT(value) - POPCOUNT(framebuffer[page][x]);
+    framebuffer[page][x] = value;
+    dirty[page].x1 = MIN(dirty[page].x1, x);
+    dirty[page].x2 = MAX(dirty[page].x2, x);
+}
+
+static void set_px(const lv_area_t *clip, int x, int y, bool set) {
+    if (!_lv_area_is_point_on(clip, &(lv_point_t){x, y}, 0)) {
+        return;
+    }
+
+    uint8_t byte = framebuffer[y / 8][x];
+
+    store(y / 8, x, set ? byte | BIT(y % 8) : byte & ~BIT(y % 8));
+}
+
+static bool clip_to_panel(lv_area_t *out, const lv_area_t *area) {
+    static const lv_area_t panel = {0, 0, PANEL_WIDTH - 1, PANEL_HEIGHT - 1};
+
+    return _lv_area_intersect(out, area, &panel);
+}
+
+void zmk_compositor_fill(const lv_area_t *area, bool set) {
+    lv_area_t draw;
+
+    if (!clip_to_panel(&draw, area)) {
+        return;
+    }
+
+    for (int page = draw.y1 / 8; page <= draw.y2 / 8; page++) {
+        int top = page * 8;
+        uint8_t rows = GENMASK(MIN(draw.y2 - top, 7), MAX(draw.y1 - top, 0));
+
+        for (int x = draw.x1; x <= draw.x2; x++) {
+            uint8_t byte = framebuffer[page][x];
+
+            store(page, x, set ? byte | rows : byte & ~rows);
+        }
+    }
+}
+
+void zmk_compositor_draw_img(const lv_area_t *clip, lv_coord_t x, lv_coord_t y,
+                             const lv_img_dsc_t *img) {
+    int stride = (img->header.w + 7) / 8;
+    lv_area_t draw;
+
+    __ASSERT(img->header.cf == LV_IMG_CF_ALPHA_1BIT, "only 1 bit alpha images are drawn");
+
+    if (!clip_to_panel(&draw, clip)) {
+        return;
+    }
+
+    for (int row = 0; row < img->header.h; row++) {
+        const uint8_t *line = img->data + row * stride;
+
+        for (int col = 0; col < img->header.w; col++) {
+            if (line[col / 8] & (0x80 >> (col % 8))) {
+                set_px(&draw, x + col, y + row, true);
+            }
+        }
+    }
+}
+
+void zmk_compositor_draw_pages(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h,
+                               const uint8_t *pages, lv_coord_t stride) {
+    __ASSERT(y % 8 == 0, "page-native sprites must be page aligned");
+
+    for (int page = 0; page < DIV_ROUND_UP(h, 8) && y / 8 + page < PANEL_PAGES; page++) {
+        uint8_t rows = GENMASK(MIN(h - 1 - page * 8, 7), 0);
+        const uint8_t *src = pages + page * stride;
+
+        for (int col = MAX(-x, 0); col < w && x + col < PANEL_WIDTH; col++) {
+            uint8_t byte = framebuffer[y / 8 + page][x + col];
+
+            store(y / 8 + page, x + col, (byte & ~rows) | (src[col] & rows));
+        }
+    }
+}
+
+static lv_coord_t text_width(const char *text) {
+    const lv_font_t *font = &arixa_font_8;
+    lv_coord_t w = 0;
+
+    for (const char *c = text; *c != '\0'; c++) {
+        w += lv_font_get_glyph_width(font, *c, c[1]) + LETTER_SPACE;
+    }
+
+    return w > 0 ? w - LETTER_SPACE : 0;
+}
+
+lv_coord_t zmk_compositor_draw_text(const lv_area_t *box, const char *text, bool align_right) {
+    const lv_font_t *font = &arixa_font_8;
+    lv_coord_t w = text_width(text);
+    lv_coord_t pen = align_right ? box->x2 + 1 - w : box->x1;
+    lv_area_t draw;
+
+    zmk_compositor_fill(box, false);
+    if (!clip_to_panel(&draw, box)) {
+        return w;
+    }
+
+    for (const char *c = text; *c != '\0'; c++) {
+        lv_font_glyph_dsc_t g;
+
+        if (!lv_font_get_glyph_dsc(font, &g, *c, c[1])) {
+            continue;
+        }
+
+        // same placement as lv_draw_letter, the bitmap rows are packed without padding
+        const uint8_t *bitmap = lv_font_get_glyph_bitmap(font, *c);
+        lv_coord_t gx = pen + g.ofs_x;
+        lv_coord_t gy = box->y1 + (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+
+        for (int i = 0; bitmap != NULL && i < g.box_w * g.box_h; i++) {
+            if (bitmap[i / 8] & (0x80 >> (i % 8))) {
+                set_px(&draw, gx + i % g.box_w, gy + i / g.box_w, true);
+            }
+        }
+
+        pen += g.adv_w + LETTER_SPACE;
+    }
+
+    return w;
+}
+
+static int write_page(int page) {
+    int x1 = dirty[page].x1;
+    int len = dirty[page].x2 - x1 + 1;
+    const uint8_t *buf = &framebuffer[page][x1];
+    struct display_buffer_descriptor desc = {
+        .buf_size = len,
+        .width = len,
+        .height = 8,
+        .pitch = len,
+    };
+
+    if (invert) {
+        for (int i = 0; i < len; i++) {
+            inverted_row[i] = ~buf[i];
+        }
+        buf = inverted_row;
+    }
+
+    return display_write(display_dev, x1, page * 8, &desc, buf);
+}
+
+static void flush_work_cb(struct k_work *work) {
+    __maybe_unused uint32_t start = k_cycle_get_32();
+    uint32_t bytes = 0;
+    uint32_t pages = 0;
+
+    for (int page = 0; page < PANEL_PAGES; page++) {
+        if (dirty[page].x1 > dirty[page].x2) {
+            continue;
+        }
+
+        // a failed page keeps its dirty range and goes out again with the next commit
+        int err = write_page(page);
+        if (err) {
+            LOG_WRN("display write failed on page %d: %d", page, err);
+            continue;
+        }
+
+        bytes += dirty[page].x2 - dirty[page].x1 + 1;
+        pages |= BIT(page);
+
+        dirty[page].x1 = PANEL_WIDTH;
+        dirty[page].x2 = -1;
+    }
+
+    if (bytes > 0) {
+        zmk_oled_theme_frame(invert ? PANEL_WIDTH * PANEL_HEIGHT - set_pixels : set_pixels);
+    }
+
+#if IS_ENABLED(CONFIG_ARIXA_RENDER_PROFILE)
+    if (bytes > 0) {
+        zmk_render_profile_record(RENDER_PROFILE_FLUSH, k_cycle_get_32() - start, bytes * 8, bytes,
+                                  pages);
+    }
+#endif
+}
+
+static K_WORK_DEFINE(flush_work, flush_work_cb);
+
+void zmk_compositor_commit() { k_work_submit_to_queue(zmk_display_work_q(), &flush_work); }
+
+// LVGL still renders its empty screen once, that must not reach the panel
+static void discard_flush_cb(struct _lv_disp_drv_t *disp_drv, const lv_area_t *area,
+                             lv_color_t *color_p) {
+    lv_disp_flush_ready(disp_drv);
+}
+
+int zmk_compositor_init() {
+    lv_disp_t *disp = lv_disp_get_default();
+    struct display_capabilities caps;
+
+    if (disp == NULL || !device_is_ready(display_dev)) {
+        return -ENODEV;
+    }
+
+    display_get_capabilities(display_dev, &caps);
+    if (!(caps.screen_info & SCREEN_INFO_MONO_VTILED) ||
+        (caps.screen_info & SCREEN_INFO_MONO_MSB_FIRST)) {
+        LOG_ERR("display is not page tiled with the top row in bit 0");
+        return -ENOTSUP;
+    }
+    invert = caps.current_pixel_format == PIXEL_FORMAT_MONO01;
+
+    disp->driver->flush_cb = discard_flush_cb;
+
+    // the first write clears whatever the panel held
+    memset(framebuffer, 0, sizeof(framebuffer));
+    set_pixels = 0;
+    for (int page = 0; page < PANEL_PAGES; page++) {
+        dirty[page].x1 = 0;
+        dirty[page].x2 = PANEL_WIDTH - 1;
+    }
+
+    zmk_compositor_commit();
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+// Draws the status screen straight into a page framebuffer, one byte per column of eight rows
+// like the SSD1306 GDDRAM, and writes the changed columns of every page to the panel.
+// Set pixels are drawn in the foreground, what LVGL would draw black. All calls must come
+// from the display work queue.
+
+int zmk_compositor_init();
+
+// Clears, or with set fills, the area clipped to the panel.
+void zmk_compositor_fill(const lv_area_t *area, bool set);
+
+// Draws the set pixels of an LV_IMG_CF_ALPHA_1BIT image with its top left corner at x, y,
+// clipped to clip. Clear pixels are transparent.
+void zmk_compositor_draw_img(const lv_area_t *clip, lv_coord_t x, lv_coord_t y,
+                             const lv_img_dsc_t *img);
+
+// Copies a page-native sprite, rows of pages with the top pixel in bit 0, to x, y. y must be a
+// multiple of 8.
+void zmk_compositor_draw_pages(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h,
+                               const uint8_t *pages, lv_coord_t stride);
+
+// Clears box and draws text into it in the status screen font, starting at its left edge or,
+// with align_right, ending at its right edge. Returns the text width in pixels.
+lv_coord_t zmk_compositor_draw_text(const lv_area_t *box, const char *text, bool align_right);
+
+// Schedules a write of everything drawn since the last one.
+void zmk_compositor_commit();
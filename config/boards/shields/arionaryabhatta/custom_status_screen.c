@@ -6,15 +6,69 @@
 
 #include "custom_status_screen.h"
 #include "widgets/battery_status.h"
+#include "widgets/local_battery.h"
+#include "widgets/power_status.h"
+#include "widgets/latency_status.h"
+#include "latency_page.h"
 #include "widgets/modifiers.h"
 #include "widgets/bongo_cat.h"
 #include "widgets/layer_status.h"
 #include "widgets/output_status.h"
 #include "widgets/hid_indicators.h"
+#include "display_flush.h"
+#include "anim_governor.h"
+#include "render_profile.h"
+#include "display_pages.h"
+#include "oled_theme.h"
+#include "status_layout.h"
+#include "compositor.h"
+#include "widgets/compositor_widgets.h"
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
+#if IS_ENABLED(CONFIG_ZMK_DISPLAY_WORK_QUEUE_DEDICATED)
+BUILD_ASSERT(CONFIG_ZMK_DISPLAY_DEDICATED_THREAD_PRIORITY > CONFIG_SYSTEM_WORKQUEUE_PRIORITY,
+             "display rendering must not preempt kscan and event processing");
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+BUILD_ASSERT(CONFIG_ZMK_DISPLAY_DEDICATED_THREAD_PRIORITY > CONFIG_ZMK_BLE_THREAD_PRIORITY,
+             "display rendering must not preempt HID report sending");
+#endif
+#endif
+
+DT_FOREACH_CHILD(LAYOUT_NODE, CHECK_WIDGET_RECT)
+
+#if IS_ENABLED(CONFIG_ARIXA_BONGO_CAT_PAGES)
+BUILD_ASSERT(DT_PROP(DT_CHILD(LAYOUT_NODE, bongo_cat), page_aligned),
+             "page-native bongo cat frames need a page-aligned bongo_cat layout");
+#endif
+
+#if IS_ENABLED(CONFIG_ARIXA_STATUS_SCREEN_FRAMEBUFFER)
+
+lv_obj_t *zmk_display_status_screen() {
+    lv_obj_t *screen;
+
+    // the compositor owns the panel, LVGL only keeps an empty screen loaded
+    screen = lv_obj_create(NULL);
+    lv_obj_remove_style_all(screen);
+
+    // render profiling needs no LVGL hooks here, the compositor records its own flushes
+    zmk_compositor_init();
+    zmk_compositor_widgets_init();
+    zmk_oled_theme_init();
+
+    return screen;
+}
+
+#else
+
+// positions and sizes come from the devicetree, so building the screen needs no layout pass
+#define PLACE_WIDGET(obj, name)                                                                    \
+    do {                                                                                           \
+        lv_obj_set_pos(obj, WIDGET_RECT(name, 0), WIDGET_Y(name));                                 \
+        lv_obj_set_size(obj, WIDGET_RECT(name, 2), WIDGET_RECT(name, 3));                          \
+    } while (0)
+
 static struct zmk_widget_output_status output_status_widget;
 static struct zmk_widget_layer_status layer_status_widget;
 static struct zmk_widget_peripheral_battery_status peripheral_battery_status_widget;
@@ -25,6 +79,20 @@ static struct zmk_widget_bongo_cat bongo_cat_widget;
 static struct zmk_widget_hid_indicators hid_indicators_widget;
 #endif
 
+#if IS_ENABLED(CONFIG_ARIXA_BATTERY_GAUGE)
+static struct zmk_widget_local_battery local_battery_widget;
+#endif
+
+#if IS_ENABLED(CONFIG_ARIXA_POWER_MODEL)
+static struct zmk_widget_power_status power_status_widget;
+#endif
+
+#if IS_ENABLED(CONFIG_ARIXA_KEY_LATENCY_PROBE)
+static struct zmk_widget_latency_status latency_status_widget;
+#endif
+
+LV_FONT_DECLARE(arixa_font_8);
+
 lv_style_t global_style;
 
 lv_obj_t *zmk_display_status_screen() {
@@ -33,31 +101,67 @@ lv_obj_t *zmk_display_status_screen() {
     screen = lv_obj_create(NULL);
 
     lv_style_init(&global_style);
-    lv_style_set_text_font(&global_style, &lv_font_unscii_8);
+    lv_style_set_text_font(&global_style, &arixa_font_8);
     lv_style_set_text_letter_space(&global_style, 1);
     lv_style_set_text_line_space(&global_style, 1);
     lv_obj_add_style(screen, &global_style, LV_PART_MAIN);
     
     zmk_widget_output_status_init(&output_status_widget, screen);
-    lv_obj_align(zmk_widget_output_status_obj(&output_status_widget), LV_ALIGN_TOP_LEFT, 0, 0);
+    PLACE_WIDGET(zmk_widget_output_status_obj(&output_status_widget), output_status);
     
     zmk_widget_bongo_cat_init(&bongo_cat_widget, screen);
-    lv_obj_align(zmk_widget_bongo_cat_obj(&bongo_cat_widget), LV_ALIGN_BOTTOM_RIGHT, 0, -7);
+    PLACE_WIDGET(zmk_widget_bongo_cat_obj(&bongo_cat_widget), bongo_cat);
 
     zmk_widget_modifiers_init(&modifiers_widget, screen);
-    lv_obj_align(zmk_widget_modifiers_obj(&modifiers_widget), LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    PLACE_WIDGET(zmk_widget_modifiers_obj(&modifiers_widget), modifiers);
     
     #if IS_ENABLED(CONFIG_ZMK_HID_INDICATORS)
     zmk_widget_hid_indicators_init(&hid_indicators_widget, screen);
-    lv_obj_align_to(zmk_widget_hid_indicators_obj(&hid_indicators_widget), zmk_widget_modifiers_obj(&modifiers_widget), LV_ALIGN_OUT_TOP_LEFT, 0, -2);
+    PLACE_WIDGET(zmk_widget_hid_indicators_obj(&hid_indicators_widget), hid_indicators);
     #endif
 
     zmk_widget_layer_status_init(&layer_status_widget, screen);
-    // lv_obj_align(zmk_widget_layer_status_obj(&layer_status_widget), LV_ALIGN_BOTTOM_LEFT, 2, -18);
-    lv_obj_align_to(zmk_widget_layer_status_obj(&layer_status_widget), zmk_widget_bongo_cat_obj(&bongo_cat_widget), LV_ALIGN_BOTTOM_LEFT, 0, 5);
+    PLACE_WIDGET(zmk_widget_layer_status_obj(&layer_status_widget), layer_status);
 
     zmk_widget_peripheral_battery_status_init(&peripheral_battery_status_widget, screen);
-    lv_obj_align(zmk_widget_peripheral_battery_status_obj(&peripheral_battery_status_widget), LV_ALIGN_TOP_RIGHT, 0, 0);
+    PLACE_WIDGET(zmk_widget_peripheral_battery_status_obj(&peripheral_battery_status_widget), battery_status);
+
+    #if IS_ENABLED(CONFIG_ARIXA_BATTERY_GAUGE)
+    zmk_widget_local_battery_init(&local_battery_widget, screen);
+    PLACE_WIDGET(zmk_widget_local_battery_obj(&local_battery_widget), local_battery);
+    #endif
+
+    #if IS_ENABLED(CONFIG_ARIXA_POWER_MODEL)
+    zmk_widget_power_status_init(&power_status_widget, screen);
+    PLACE_WIDGET(zmk_widget_power_status_obj(&power_status_widget), power_status);
+    #endif
+
+    #if IS_ENABLED(CONFIG_ARIXA_KEY_LATENCY_PROBE)
+    zmk_widget_latency_status_init(&latency_status_widget, screen);
+    PLACE_WIDGET(zmk_widget_latency_status_obj(&latency_status_widget), latency_status);
+    #endif
+
+    #if IS_ENABLED(CONFIG_ARIXA_LATENCY_PAGE)
+    zmk_latency_page_init(&global_style);
+    #endif
+
+    zmk_anim_governor_init();
+
+    #if IS_ENABLED(CONFIG_ARIXA_DISPLAY_PAGE_NATIVE)
+    zmk_display_pages_init();
+    #endif
+
+    #if IS_ENABLED(CONFIG_ARIXA_DISPLAY_SHADOW_FLUSH)
+    zmk_display_flush_init();
+    #endif
+
+    zmk_oled_theme_init();
+
+    #if IS_ENABLED(CONFIG_ARIXA_RENDER_PROFILE)
+    zmk_render_profile_init();
+    #endif
 
     return screen;
-}
\ No newline at end of file
+}
+
+#endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <lvgl.h>
+
+#include "display_flush.h"
+#include "oled_theme.h"
+
+#define DISPLAY_NODE DT_CHOSEN(zephyr_display)
+#define PANEL_WIDTH DT_PROP(DISPLAY_NODE, width)
+#define PANEL_PAGES (DT_PROP(DISPLAY_NODE, height) / 8)
+
+BUILD_ASSERT(PANEL_PAGES <= 32, "page_valid mask only covers 32 pages");
+
+static const struct device *display_dev = DEVICE_DT_GET(DISPLAY_NODE);
+
+// what the panel GDDRAM holds, in the same vertical-byte page layout LVGL renders into
+static uint8_t shadow[PANEL_PAGES][PANEL_WIDTH];
+static uint32_t page_valid;
+
+// set bits in the shadow, the pixels the panel lights in normal display mode
+static uint32_t shadow_set_bits;
+
+static void (*lvgl_flush_cb)(struct _lv_disp_drv_t *disp_drv, const lv_area_t *area,
+                             lv_color_t *color_p);
+
+static struct zmk_display_flush_stats stats;
+static uint32_t window_bytes;
+static int64_t window_start;
+
+static int write_run(int x, int page, const uint8_t *buf, int len) {
+    struct display_buffer_descriptor desc = {
+        .buf_size = len,
+        .width = len,
+        .height = 8,
+        .pitch = len,
+    };
+    int err = display_write(display_dev, x, page * 8, &desc, buf);
+
+    // the panel may hold part of the run, so the page is sent whole on the next flush
+    if (err) {
+        LOG_WRN("display write failed on page %d: %d", page, err);
+        page_valid &= ~BIT(page);
+        return err;
+    }
+
+    for (int i = 0; i < len; i++) {
+        shadow_set_bits += POPCOUNT(buf[i]) - POPCOUNT(shadow[page][x + i]);
+    }
+    memcpy(&shadow[page][x], buf, len);
+
+    stats.bytes_sent += len;
+    stats.writes++;
+    window_bytes += len;
+    return 0;
+}
+
+static void flush_page(int x1, int page, const uint8_t *row, int w) {
+    const uint8_t *panel = &shadow[page][x1];
+    int run_start = -1;
+    int run_end = -1;
+
+    if (!(page_valid & BIT(page))) {
+        if (write_run(x1, page, row, w) == 0 && w == PANEL_WIDTH) {
+            page_valid |= BIT(page);
+        }
+        return;
+    }
+
+    for (int x = 0; x < w; x++) {
+        if (row[x] == panel[x]) {
+            continue;
+        }
+
+        // a new write costs its addressing commands, so short unchanged gaps are resent instead
+        if (run_start >= 0 && x - run_end - 1 > CONFIG_ARIXA_DISPLAY_SHADOW_MERGE_GAP) {
+            write_run(x1 + run_start, page, row + run_start, run_end - run_start + 1);
+            run_start = -1;
+        }
+
+        if (run_start < 0) {
+            run_start = x;
+        }
+        run_end = x;
+    }
+
+    if (run_start >= 0) {
+        write_run(x1 + run_start, page, row + run_start, run_end - run_start + 1);
+    }
+}
+
+static void update_window() {
+    int64_t now = k_uptime_get();
+
+    if (now - window_start < 1000) {
+        return;
+    }
+
+    stats.bytes_per_sec = window_bytes * 1000 / (now - window_start);
+    LOG_DBG("display flush: %u B/s, %u B sent, %u B skipped", stats.bytes_per_sec,
+            stats.bytes_sent, stats.bytes_skipped);
+
+    window_bytes = 0;
+    window_start = now;
+}
+
+static void shadow_flush_cb(struct _lv_disp_drv_t *disp_drv, const lv_area_t *area,
+                            lv_color_t *color_p) {
+    const uint8_t *buf = (const uint8_t *)color_p;
+    int w = lv_area_get_width(area);
+    int first_page = area->y1 / 8;
+    int last_page = area->y2 / 8;
+
+    // the rounder keeps areas page aligned, anything else goes out untouched
+    if (area->y1 % 8 != 0 || area->y2 % 8 != 7) {
+        for (int page = first_page; page <= last_page; page++) {
+            page_valid &= ~BIT(page);
+        }
+        lvgl_flush_cb(disp_drv, area, color_p);
+        return;
+    }
+
+    uint32_t sent = stats.bytes_sent;
+
+    for (int page = first_page; page <= last_page; page++) {
+        flush_page(area->x1, page, buf + (page - first_page) * w, w);
+    }
+
+    stats.bytes_skipped += w * (last_page - first_page + 1) - (stats.bytes_sent - sent);
+    update_window();
+
+    if (stats.bytes_sent != sent) {
+        zmk_oled_theme_frame(shadow_set_bits);
+    }
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+void zmk_display_flush_invalidate() { page_valid = 0; }
+
+void zmk_display_flush_get_stats(struct zmk_display_flush_stats *out) { *out = stats; }
+
+int zmk_display_flush_init() {
+    lv_disp_t *disp = lv_disp_get_default();
+    struct display_capabilities caps;
+
+    if (disp == NULL || !device_is_ready(display_dev)) {
+        return -ENODEV;
+    }
+
+    display_get_capabilities(display_dev, &caps);
+    if (!(caps.screen_info & SCREEN_INFO_MONO_VTILED)) {
+        LOG_WRN("display is not page tiled, shadow flush disabled");
+        return -ENOTSUP;
+    }
+
+    if (lvgl_flush_cb == NULL) {
+        lvgl_flush_cb = disp->driver->flush_cb;
+        disp->driver->flush_cb = shadow_flush_cb;
+    }
+
+    page_valid = 0;
+    window_start = k_uptime_get();
+
+    return 0;
+}
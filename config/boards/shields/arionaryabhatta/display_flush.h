@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+struct zmk_display_flush_stats {
+    uint32_t bytes_sent;
+    uint32_t bytes_skipped;
+    uint32_t writes;
+    uint32_t bytes_per_sec; // bytes sent during the last complete one second window
+};
+
+int zmk_display_flush_init();
+void zmk_display_flush_invalidate();
+void zmk_display_flush_get_stats(struct zmk_display_flush_stats *stats);
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "display_pages.h"
+
+static const struct device *display_dev = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+// whether a set bit in the panel's page bytes is a black pixel
+static bool black_is_set;
+
+// The generic Zephyr callback checks the tiling, bit order and pixel format for every pixel.
+// These are fixed once the panel is known to be page tiled with the top row in bit 0.
+static void set_px_black_set(lv_disp_drv_t *disp_drv, uint8_t *buf, lv_coord_t buf_w,
+                             lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa) {
+    uint8_t *byte = buf + x + (y >> 3) * buf_w;
+
+    if (color.full == 0) {
+        *byte |= BIT(y & 7);
+    } else {
+        *byte &= ~BIT(y & 7);
+    }
+}
+
+static void set_px_black_clear(lv_disp_drv_t *disp_drv, uint8_t *buf, lv_coord_t buf_w,
+                               lv_coord_t x, lv_coord_t y, lv_color_t color, lv_opa_t opa) {
+    uint8_t *byte = buf + x + (y >> 3) * buf_w;
+
+    if (color.full == 0) {
+        *byte &= ~BIT(y & 7);
+    } else {
+        *byte |= BIT(y & 7);
+    }
+}
+
+void zmk_display_pages_draw(lv_draw_ctx_t *draw_ctx, const lv_area_t *coords,
+                            const uint8_t *pages, lv_coord_t stride) {
+    const lv_area_t *buf_area = draw_ctx->buf_area;
+    lv_coord_t buf_w = lv_area_get_width(buf_area);
+    lv_area_t draw;
+
+    __ASSERT(coords->y1 % 8 == 0 && buf_area->y1 % 8 == 0, "sprite and buffer must be page aligned");
+
+    if (!_lv_area_intersect(&draw, draw_ctx->clip_area, coords)) {
+        return;
+    }
+
+    lv_coord_t first = (draw.y1 - coords->y1) / 8;
+    lv_coord_t last = (draw.y2 - coords->y1) / 8;
+    lv_coord_t w = lv_area_get_width(&draw);
+
+    for (lv_coord_t page = first; page <= last; page++) {
+        lv_coord_t top = coords->y1 + page * 8;
+        uint8_t rows = GENMASK(MIN(draw.y2 - top, 7), MAX(draw.y1 - top, 0));
+        const uint8_t *src = pages + page * stride + (draw.x1 - coords->x1);
+        uint8_t *dst = (uint8_t *)draw_ctx->buf + (top - buf_area->y1) / 8 * buf_w +
+                       (draw.x1 - buf_area->x1);
+
+        for (lv_coord_t x = 0; x < w; x++) {
+            if (black_is_set) {
+                dst[x] |= src[x] & rows;
+            } else {
+                dst[x] &= ~(src[x] & rows);
+            }
+        }
+    }
+}
+
+int zmk_display_pages_init() {
+    lv_disp_t *disp = lv_disp_get_default();
+    struct display_capabilities caps;
+
+    if (disp == NULL || !device_is_ready(display_dev)) {
+        return -ENODEV;
+    }
+
+    display_get_capabilities(display_dev, &caps);
+    if (!(caps.screen_info & SCREEN_INFO_MONO_VTILED) ||
+        (caps.screen_info & SCREEN_INFO_MONO_MSB_FIRST)) {
+        LOG_ERR("display is not page tiled with the top row in bit 0");
+        return -ENOTSUP;
+    }
+
+    // ask the stock callback how it encodes black rather than decoding the pixel format again
+    uint8_t probe = 0;
+    disp->driver->set_px_cb(disp->driver, &probe, 1, 0, 0, lv_color_black(), LV_OPA_COVER);
+    black_is_set = probe != 0;
+
+    disp->driver->set_px_cb = black_is_set ? set_px_black_set : set_px_black_clear;
+
+    return 0;
+}
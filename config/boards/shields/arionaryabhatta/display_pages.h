@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+int zmk_display_pages_init();
+
+// Ors a page-native 1 bit sprite into the draw buffer: rows of pages, each byte one column of
+// eight pixels with the top pixel in bit 0. Set bits draw black, clear bits are transparent.
+// coords->y1 must be a multiple of 8.
+void zmk_display_pages_draw(lv_draw_ctx_t *draw_ctx, const lv_area_t *coords,
+                            const uint8_t *pages, lv_coord_t stride);
@@ -0,0 +1,11 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include "battery_gauge_changed.h"
+
+ZMK_EVENT_IMPL(zmk_battery_gauge_changed);
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/event_manager.h>
+
+#include "../battery_gauge.h"
+
+// Raised when the local cell's state of charge, charging state or time to empty changes.
+struct zmk_battery_gauge_changed {
+    struct zmk_battery_gauge_state state;
+};
+
+ZMK_EVENT_DECLARE(zmk_battery_gauge_changed);
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/event_manager.h>
+
+// Raised only when the explicit modifier byte of the HID report changes, so consumers of
+// modifier state are not woken by ordinary keypresses.
+struct zmk_explicit_mods_changed {
+    uint8_t modifiers;
+    int64_t timestamp;
+};
+
+ZMK_EVENT_DECLARE(zmk_explicit_mods_changed);
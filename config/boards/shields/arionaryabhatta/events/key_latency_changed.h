@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/event_manager.h>
+
+// Raised after every window of traced presses with their average edge to report latency.
+struct zmk_key_latency_changed {
+    uint32_t avg_us;
+};
+
+ZMK_EVENT_DECLARE(zmk_key_latency_changed);
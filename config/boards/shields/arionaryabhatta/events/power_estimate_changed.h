@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/event_manager.h>
+
+#include "../power_model.h"
+
+// Raised at the end of an accounting window when the total estimate moved by a tenth of a mA.
+struct zmk_power_estimate_changed {
+    struct zmk_power_estimate estimate;
+};
+
+ZMK_EVENT_DECLARE(zmk_power_estimate_changed);
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/matrix.h>
+#include <zmk/events/position_state_changed.h>
+#include <zmk/events/keycode_state_changed.h>
+
+#include "key_latency.h"
+#include "events/key_latency_changed.h"
+
+#if IS_ENABLED(CONFIG_ARIXA_KSCAN_DEBOUNCE)
+#include "kscan_debounce.h"
+
+#define MATRIX_NODE DT_PHANDLE(DT_COMPAT_GET_ANY_STATUS_OKAY(arixa_kscan_debounce), kscan)
+#else
+#define MATRIX_NODE DT_CHOSEN(zmk_kscan)
+#endif
+
+BUILD_ASSERT(DT_NODE_HAS_COMPAT(MATRIX_NODE, zmk_kscan_gpio_matrix),
+             "the latency probe watches the row inputs of a zmk,kscan-gpio-matrix");
+
+#define LATENCY_WINDOW 32
+
+// a held press whose binding has not produced a keycode by then is dropped, hold-taps resolve well
+// within it
+#define TRACE_TIMEOUT_MS 1000
+
+// logged with every window, the builds to compare differ in it
+#if !IS_ENABLED(CONFIG_ZMK_DISPLAY)
+#define DISPLAY_MODE "off"
+#elif IS_ENABLED(CONFIG_ZMK_DISPLAY_WORK_QUEUE_DEDICATED)
+#define DISPLAY_MODE "on its own queue"
+#else
+#define DISPLAY_MODE "on the system queue"
+#endif
+
+struct latency_window {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+};
+
+static const char *const stage_names[ZMK_KEY_LATENCY_STAGE_COUNT] = {
+    [ZMK_KEY_LATENCY_SCAN] = "scan",
+    [ZMK_KEY_LATENCY_BINDING] = "binding",
+    [ZMK_KEY_LATENCY_REPORT] = "report",
+    [ZMK_KEY_LATENCY_TOTAL] = "total",
+};
+
+static struct zmk_key_latency_stats stats[ZMK_KEY_LATENCY_STAGE_COUNT];
+static struct k_spinlock lock;
+
+static struct latency_window window = {.min_us = UINT32_MAX};
+
+// Every held position traces its press until the first keycode its binding raises. ZMK stamps that
+// keycode with the press's timestamp, which is how it is matched. Keycodes from sensors and combos
+// carry their own event's timestamp and match no press. Presses that raise no keycode, such as
+// bootloader, underglow and layer keys, are dropped on release or after TRACE_TIMEOUT_MS.
+struct press_trace {
+    int64_t timestamp;
+    uint32_t edge_cycles;
+    uint32_t position_cycles;
+    uint32_t binding_cycles;
+    bool pending;
+    bool bound;
+};
+
+static struct press_trace traces[ZMK_KEYMAP_LEN];
+
+// The matrix arms its row interrupts while idle, takes the first one and polls until every key is
+// up. The probe adds its own callback on the same inputs, so the first press on an idle matrix is
+// stamped at its interrupt, with or without the per key debounce in front of the matrix.
+static const struct gpio_dt_spec rows[] = {
+    DT_FOREACH_PROP_ELEM_SEP(MATRIX_NODE, row_gpios, GPIO_DT_SPEC_GET_BY_IDX, (, ))};
+static struct gpio_callback row_callbacks[ARRAY_SIZE(rows)];
+static uint32_t irq_cycles;
+static atomic_t irq_pending; // until a press takes irq_cycles as its edge
+
+static void row_irq_cb(const struct device *port, struct gpio_callback *cb, uint32_t pins) {
+    irq_cycles = k_cycle_get_32();
+    atomic_set(&irq_pending, 1);
+}
+
+// Presses read while the matrix polls have no interrupt. The debounce driver stamps the scan that
+// read them, without it nothing sees the scan and the scan stage reads 0 for them.
+static uint32_t press_edge_cycles(uint32_t position, uint32_t position_cycles) {
+    if (atomic_clear(&irq_pending)) {
+        return irq_cycles;
+    }
+
+#if IS_ENABLED(CONFIG_ARIXA_KSCAN_DEBOUNCE)
+    return zmk_kscan_debounce_press_cycles(position);
+#else
+    return position_cycles;
+#endif
+}
+
+const char *zmk_key_latency_stage_name(enum zmk_key_latency_stage stage) {
+    return stage_names[stage];
+}
+
+void zmk_key_latency_get(enum zmk_key_latency_stage stage, struct zmk_key_latency_stats *out) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    *out = stats[stage];
+    k_spin_unlock(&lock, key);
+}
+
+void zmk_key_latency_reset() {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    memset(stats, 0, sizeof(stats));
+    k_spin_unlock(&lock, key);
+}
+
+// with the lock held
+static void stage_add(enum zmk_key_latency_stage stage, uint32_t us) {
+    struct zmk_key_latency_stats *s = &stats[stage];
+    int bucket = MIN(us > 0 ? 31 - __builtin_clz(us) : 0, ZMK_KEY_LATENCY_BUCKETS - 1);
+
+    s->min_us = s->count == 0 ? us : MIN(s->min_us, us);
+    s->max_us = MAX(s->max_us, us);
+    s->total_us += us;
+    s->count++;
+    if (s->buckets[bucket] < UINT16_MAX) {
+        s->buckets[bucket]++;
+    }
+}
+
+static uint32_t cycles_to_us(uint32_t from, uint32_t to) { return k_cyc_to_us_floor32(to - from); }
+
+// the pending press the keycode came from, NULL for keycodes from anything else
+static struct press_trace *find_trace(const struct zmk_keycode_state_changed *kc, bool bound) {
+    for (int i = 0; i < ARRAY_SIZE(traces); i++) {
+        struct press_trace *trace = &traces[i];
+
+        if (!trace->pending || trace->bound != bound || trace->timestamp != kc->timestamp) {
+            continue;
+        }
+        if (k_uptime_get() - trace->timestamp > TRACE_TIMEOUT_MS) {
+            trace->pending = false;
+            continue;
+        }
+
+        return trace;
+    }
+
+    return NULL;
+}
+
+static void record_press(const struct press_trace *press, uint32_t report_cycles) {
+    uint32_t total_us = cycles_to_us(press->edge_cycles, report_cycles);
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    stage_add(ZMK_KEY_LATENCY_SCAN, cycles_to_us(press->edge_cycles, press->position_cycles));
+    stage_add(ZMK_KEY_LATENCY_BINDING,
+              cycles_to_us(press->position_cycles, press->binding_cycles));
+    stage_add(ZMK_KEY_LATENCY_REPORT, cycles_to_us(press->binding_cycles, report_cycles));
+    stage_add(ZMK_KEY_LATENCY_TOTAL, total_us);
+    k_spin_unlock(&lock, key);
+
+    window.min_us = MIN(window.min_us, total_us);
+    window.max_us = MAX(window.max_us, total_us);
+    window.sum_us += total_us;
+
+    if (++window.count < LATENCY_WINDOW) {
+        return;
+    }
+
+    LOG_INF("matrix edge to queued report, display %s: min %u us, avg %u us, max %u us",
+            DISPLAY_MODE, window.min_us, (uint32_t)(window.sum_us / window.count), window.max_us);
+
+    raise_zmk_key_latency_changed(
+        (struct zmk_key_latency_changed){.avg_us = window.sum_us / window.count});
+
+    window = (struct latency_window){.min_us = UINT32_MAX};
+}
+
+// Listeners run in name order. binding_latency sees a keycode before hid_listener queues its
+// report, key_latency sees it after, and sees positions before keymap resolves their bindings.
+
+static int binding_latency_listener(const zmk_event_t *eh) {
+    const struct zmk_keycode_state_changed *kc = as_zmk_keycode_state_changed(eh);
+    struct press_trace *press = kc->state ? find_trace(kc, false) : NULL;
+
+    if (press != NULL) {
+        press->binding_cycles = k_cycle_get_32();
+        press->bound = true;
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(binding_latency, binding_latency_listener);
+ZMK_SUBSCRIPTION(binding_latency, zmk_keycode_state_changed);
+
+static int key_latency_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *pos = as_zmk_position_state_changed(eh);
+    if (pos != NULL) {
+        if (pos->position >= ARRAY_SIZE(traces)) {
+            return ZMK_EV_EVENT_BUBBLE;
+        }
+
+        struct press_trace *press = &traces[pos->position];
+
+        if (pos->state) {
+            uint32_t now = k_cycle_get_32();
+
+            *press = (struct press_trace){
+                .timestamp = pos->timestamp,
+                .edge_cycles = press_edge_cycles(pos->position, now),
+                .position_cycles = now,
+                .pending = true,
+            };
+        } else {
+            // a hold-tap resolving to its tap has raised its keycode before this release
+            press->pending = false;
+        }
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    const struct zmk_keycode_state_changed *kc = as_zmk_keycode_state_changed(eh);
+    struct press_trace *press = (kc != NULL && kc->state) ? find_trace(kc, true) : NULL;
+
+    if (press != NULL) {
+        press->pending = false;
+        record_press(press, k_cycle_get_32());
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(key_latency, key_latency_listener);
+ZMK_SUBSCRIPTION(key_latency, zmk_position_state_changed);
+ZMK_SUBSCRIPTION(key_latency, zmk_keycode_state_changed);
+
+static int key_latency_init() {
+    for (int i = 0; i < ARRAY_SIZE(rows); i++) {
+        gpio_init_callback(&row_callbacks[i], row_irq_cb, BIT(rows[i].pin));
+
+        int err = gpio_add_callback(rows[i].port, &row_callbacks[i]);
+        if (err != 0) {
+            LOG_ERR("latency probe cannot watch matrix row %d: %d", i, err);
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+SYS_INIT(key_latency_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+static int cmd_latency_show(const struct shell *sh, size_t argc, char **argv) {
+    struct zmk_key_latency_stats s;
+
+    for (int stage = 0; stage < ZMK_KEY_LATENCY_STAGE_COUNT; stage++) {
+        char line[ZMK_KEY_LATENCY_BUCKETS * 14];
+        int len = 0;
+
+        zmk_key_latency_get(stage, &s);
+        if (s.count == 0) {
+            continue;
+        }
+
+        for (int i = 0; i < ZMK_KEY_LATENCY_BUCKETS; i++) {
+            if (s.buckets[i] > 0 && len < (int)sizeof(line)) {
+                len += snprintk(line + len, sizeof(line) - len, " <%u:%u",
+                                i == ZMK_KEY_LATENCY_BUCKETS - 1 ? UINT32_MAX
+                                                                 : (uint32_t)BIT(i + 1) - 1,
+                                s.buckets[i]);
+            }
+        }
+
+        shell_print(sh, "%s: %u presses, min %u us, avg %u us, max %u us", stage_names[stage],
+                    s.count, s.min_us, (uint32_t)(s.total_us / s.count), s.max_us);
+        shell_print(sh, "    us%s", line);
+    }
+
+    return 0;
+}
+
+static int cmd_latency_reset(const struct shell *sh, size_t argc, char **argv) {
+    zmk_key_latency_reset();
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_latency,
+                               SHELL_CMD(reset, NULL, "Clear the histograms", cmd_latency_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((arixa), latency, &sub_latency, "Key press latency histograms per stage",
+                 cmd_latency_show, 1, 0);
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+enum zmk_key_latency_stage {
+    ZMK_KEY_LATENCY_SCAN,    // matrix edge to the position event, combos waiting included
+    ZMK_KEY_LATENCY_BINDING, // position event to the keycode its binding resolved to
+    ZMK_KEY_LATENCY_REPORT,  // keycode to the HID report queued for USB or BLE
+    ZMK_KEY_LATENCY_TOTAL,   // matrix edge to the HID report queued
+    ZMK_KEY_LATENCY_STAGE_COUNT
+};
+
+// log2 buckets, bucket n counts latencies in [2^n, 2^(n+1)) us and bucket 0 also holds 0
+#define ZMK_KEY_LATENCY_BUCKETS 20
+
+struct zmk_key_latency_stats {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint16_t buckets[ZMK_KEY_LATENCY_BUCKETS];
+};
+
+const char *zmk_key_latency_stage_name(enum zmk_key_latency_stage stage);
+void zmk_key_latency_get(enum zmk_key_latency_stage stage, struct zmk_key_latency_stats *out);
+void zmk_key_latency_reset();
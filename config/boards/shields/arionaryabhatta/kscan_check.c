@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+
+// Build time checks that the matrix transform, the kscan GPIO lists and the physical layout
+// describe the same matrix. Nothing here ends up in the image.
+
+#define CHOSEN_NODE DT_CHOSEN(zmk_kscan)
+#define LAYOUT_NODE DT_CHOSEN(zmk_physical_layout)
+#define TRANSFORM_NODE DT_PHANDLE(LAYOUT_NODE, transform)
+#define HAS_DEBOUNCE DT_NODE_HAS_COMPAT(CHOSEN_NODE, arixa_kscan_debounce)
+
+// the matrix itself, behind the per key debounce when there is one
+#define KSCAN_NODE COND_CODE_1(HAS_DEBOUNCE, (DT_PHANDLE(CHOSEN_NODE, kscan)), (CHOSEN_NODE))
+
+BUILD_ASSERT(DT_NODE_HAS_COMPAT(KSCAN_NODE, zmk_kscan_gpio_matrix),
+             "these checks are written for zmk,kscan-gpio-matrix");
+BUILD_ASSERT(DT_SAME_NODE(DT_PHANDLE(LAYOUT_NODE, kscan), CHOSEN_NODE),
+             "the physical layout must use the chosen kscan");
+
+#if HAS_DEBOUNCE
+BUILD_ASSERT(DT_SAME_NODE(DT_PHANDLE(CHOSEN_NODE, transform), TRANSFORM_NODE),
+             "the per key debounce must index positions by the layout's transform");
+BUILD_ASSERT(DT_PROP_OR(KSCAN_NODE, debounce_press_ms, 1) == 0 &&
+                 DT_PROP_OR(KSCAN_NODE, debounce_release_ms, 1) == 0,
+             "the matrix must pass raw edges to the per key debounce");
+#endif
+
+// with col2row the rows are the interrupt inputs and the columns the driven outputs
+BUILD_ASSERT(DT_ENUM_IDX(KSCAN_NODE, diode_direction) == 1,
+             "row-gpios are wired as inputs, diode-direction must be col2row");
+BUILD_ASSERT(DT_PROP(TRANSFORM_NODE, rows) == DT_PROP_LEN(KSCAN_NODE, row_gpios),
+             "transform rows must match the number of row-gpios");
+BUILD_ASSERT(DT_PROP(TRANSFORM_NODE, columns) == DT_PROP_LEN(KSCAN_NODE, col_gpios),
+             "transform columns must match the number of col-gpios");
+BUILD_ASSERT(DT_PROP_LEN(TRANSFORM_NODE, map) == DT_PROP_LEN(LAYOUT_NODE, keys),
+             "every physical key needs exactly one transform entry");
+
+// RC(row, col) is row << 8 | col
+#define MAP_ROW(idx) (DT_PROP_BY_IDX(TRANSFORM_NODE, map, idx) >> 8)
+#define MAP_COL(idx) (DT_PROP_BY_IDX(TRANSFORM_NODE, map, idx) & 0xFF)
+
+#define CHECK_MAP_ENTRY(node, prop, idx)                                                           \
+    BUILD_ASSERT(MAP_ROW(idx) < DT_PROP(TRANSFORM_NODE, rows),                                     \
+                 "transform entry " #idx " is past the last row");                                 \
+    BUILD_ASSERT(MAP_COL(idx) < DT_PROP(TRANSFORM_NODE, columns),                                  \
+                 "transform entry " #idx " is past the last column");
+
+DT_FOREACH_PROP_ELEM(TRANSFORM_NODE, map, CHECK_MAP_ENTRY)
+
+// A matrix position listed twice fails as a redeclared enumerator named after its RC value.
+#define MAP_POSITION(node, prop, idx)                                                              \
+    UTIL_CAT(transform_position_, DT_PROP_BY_IDX(node, prop, idx)),
+
+enum transform_positions { DT_FOREACH_PROP_ELEM(TRANSFORM_NODE, map, MAP_POSITION) };
@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT arixa_kscan_debounce
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/kscan.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include "kscan_debounce.h"
+
+// Edges from the matrix arrive on the system work queue, the deadline work runs there too, so the
+// key states need no lock.
+
+struct debounce_key {
+    int64_t last_edge; // uptime of the last raw edge
+    uint32_t edge_cycles;
+    bool raw;
+    bool reported;
+};
+
+struct debounce_config {
+    const struct device *kscan;
+    uint8_t rows;
+    uint8_t columns;
+    uint8_t positions;
+    const uint8_t *position_of; // position + 1 for every row * columns + column, 0 when unmapped
+    const uint8_t *press_ms;
+    const uint8_t *release_ms;
+};
+
+struct debounce_data {
+    const struct device *dev;
+    kscan_callback_t callback;
+    struct k_work_delayable deadline_work;
+    struct debounce_key *keys; // rows * columns
+    atomic_t *chatter;         // per position, edges that undid a change still being filtered
+    uint32_t *press_cycles;    // per position, edge_cycles of the last reported press
+};
+
+// When a key whose raw state differs from the reported one may report it, once it has read that
+// state for its press-ms or release-ms. A press-ms of 0 reports presses on their first edge, the
+// bounces after it are then caught by release-ms.
+static int64_t key_deadline(const struct debounce_config *cfg, const struct debounce_key *key,
+                            uint8_t position) {
+    return key->last_edge + (key->raw ? cfg->press_ms[position] : cfg->release_ms[position]);
+}
+
+static void process(const struct device *dev) {
+    const struct debounce_config *cfg = dev->config;
+    struct debounce_data *data = dev->data;
+    int64_t now = k_uptime_get();
+    int64_t next = INT64_MAX;
+
+    for (int i = 0; i < cfg->rows * cfg->columns; i++) {
+        struct debounce_key *key = &data->keys[i];
+
+        if (key->raw == key->reported || cfg->position_of[i] == 0) {
+            continue;
+        }
+
+        uint8_t position = cfg->position_of[i] - 1;
+        int64_t deadline = key_deadline(cfg, key, position);
+        if (deadline > now) {
+            next = MIN(next, deadline);
+            continue;
+        }
+
+        key->reported = key->raw;
+        if (key->reported) {
+            data->press_cycles[position] = key->edge_cycles;
+        }
+
+        if (data->callback != NULL) {
+            data->callback(dev, i / cfg->columns, i % cfg->columns, key->reported);
+        }
+    }
+
+    if (next != INT64_MAX) {
+        k_work_reschedule(&data->deadline_work, K_MSEC(next - now));
+    }
+}
+
+static void deadline_work_cb(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct debounce_data *data = CONTAINER_OF(dwork, struct debounce_data, deadline_work);
+
+    process(data->dev);
+}
+
+static void raw_edge(const struct device *dev, uint32_t row, uint32_t column, bool pressed) {
+    const struct debounce_config *cfg = dev->config;
+    struct debounce_data *data = dev->data;
+
+    if (row >= cfg->rows || column >= cfg->columns) {
+        return;
+    }
+
+    int i = row * cfg->columns + column;
+    struct debounce_key *key = &data->keys[i];
+
+    if (pressed == key->raw) {
+        return;
+    }
+
+    // a change still being filtered is undone, the switch bounced
+    if (key->raw != key->reported && cfg->position_of[i] != 0) {
+        atomic_inc(&data->chatter[cfg->position_of[i] - 1]);
+    }
+
+    key->raw = pressed;
+    key->last_edge = k_uptime_get();
+    key->edge_cycles = k_cycle_get_32();
+    process(dev);
+}
+
+static int debounce_configure(const struct device *dev, kscan_callback_t callback) {
+    struct debounce_data *data = dev->data;
+
+    if (callback == NULL) {
+        return -EINVAL;
+    }
+
+    data->callback = callback;
+    return 0;
+}
+
+static int debounce_enable(const struct device *dev) {
+    const struct debounce_config *cfg = dev->config;
+
+    return kscan_enable_callback(cfg->kscan);
+}
+
+static int debounce_disable(const struct device *dev) {
+    const struct debounce_config *cfg = dev->config;
+
+    return kscan_disable_callback(cfg->kscan);
+}
+
+static const struct kscan_driver_api debounce_api = {
+    .config = debounce_configure,
+    .enable_callback = debounce_enable,
+    .disable_callback = debounce_disable,
+};
+
+// RC(row, col) is row << 8 | col
+#define TRANSFORM(n) DT_INST_PHANDLE(n, transform)
+#define MATRIX(n) DT_INST_PHANDLE(n, kscan)
+#define MAP_INDEX(n, idx)                                                                          \
+    ((DT_PROP_BY_IDX(TRANSFORM(n), map, idx) >> 8) * DT_PROP(TRANSFORM(n), columns) +              \
+     (DT_PROP_BY_IDX(TRANSFORM(n), map, idx) & 0xFF))
+#define POSITION_OF(node, prop, idx, n) [MAP_INDEX(n, idx)] = idx + 1,
+
+#define KSCAN_DEBOUNCE_INST(n)                                                                     \
+    BUILD_ASSERT(DT_INST_PROP_LEN(n, press_ms) == DT_PROP_LEN(TRANSFORM(n), map),                  \
+                 "press-ms needs one entry per transform position");                               \
+    BUILD_ASSERT(DT_INST_PROP_LEN(n, release_ms) == DT_PROP_LEN(TRANSFORM(n), map),                \
+                 "release-ms needs one entry per transform position");                             \
+                                                                                                   \
+    static const uint8_t position_of_##n[DT_PROP(TRANSFORM(n), rows) *                             \
+                                         DT_PROP(TRANSFORM(n), columns)] = {                       \
+        DT_FOREACH_PROP_ELEM_VARGS(TRANSFORM(n), map, POSITION_OF, n)};                            \
+    static const uint8_t press_ms_##n[] = DT_INST_PROP(n, press_ms);                               \
+    static const uint8_t release_ms_##n[] = DT_INST_PROP(n, release_ms);                           \
+    static struct debounce_key keys_##n[ARRAY_SIZE(position_of_##n)];                              \
+    static atomic_t chatter_##n[ARRAY_SIZE(press_ms_##n)];                                         \
+    static uint32_t press_cycles_##n[ARRAY_SIZE(press_ms_##n)];                                    \
+                                                                                                   \
+    static struct debounce_data debounce_data_##n = {                                              \
+        .keys = keys_##n,                                                                          \
+        .chatter = chatter_##n,                                                                    \
+        .press_cycles = press_cycles_##n,                                                          \
+    };                                                                                             \
+                                                                                                   \
+    static const struct debounce_config debounce_config_##n = {                                    \
+        .kscan = DEVICE_DT_GET(MATRIX(n)),                                                         \
+        .rows = DT_PROP(TRANSFORM(n), rows),                                                       \
+        .columns = DT_PROP(TRANSFORM(n), columns),                                                 \
+        .positions = ARRAY_SIZE(press_ms_##n),                                                     \
+        .position_of = position_of_##n,                                                            \
+        .press_ms = press_ms_##n,                                                                  \
+        .release_ms = release_ms_##n,                                                              \
+    };                                                                                             \
+                                                                                                   \
+    static void raw_edge_##n(const struct device *kscan, uint32_t row, uint32_t column,            \
+                             bool pressed) {                                                       \
+        raw_edge(DEVICE_DT_INST_GET(n), row, column, pressed);                                     \
+    }                                                                                              \
+                                                                                                   \
+    static int debounce_init_##n(const struct device *dev) {                                       \
+        const struct debounce_config *cfg = dev->config;                                           \
+        struct debounce_data *data = dev->data;                                                    \
+                                                                                                   \
+        if (!device_is_ready(cfg->kscan)) {                                                        \
+            return -ENODEV;                                                                        \
+        }                                                                                          \
+                                                                                                   \
+        data->dev = dev;                                                                           \
+        k_work_init_delayable(&data->deadline_work, deadline_work_cb);                             \
+        return kscan_config(cfg->kscan, raw_edge_##n);                                             \
+    }                                                                                              \
+                                                                                                   \
+    DEVICE_DT_INST_DEFINE(n, debounce_init_##n, NULL, &debounce_data_##n, &debounce_config_##n,    \
+                          POST_KERNEL, CONFIG_KSCAN_INIT_PRIORITY, &debounce_api);
+
+DT_INST_FOREACH_STATUS_OKAY(KSCAN_DEBOUNCE_INST)
+
+static const struct device *const debounce_dev = DEVICE_DT_GET(DT_DRV_INST(0));
+
+uint32_t zmk_kscan_debounce_press_cycles(uint32_t position) {
+    const struct debounce_config *cfg = debounce_dev->config;
+    struct debounce_data *data = debounce_dev->data;
+
+    return position < cfg->positions ? data->press_cycles[position] : 0;
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+static int cmd_debounce_show(const struct shell *sh, size_t argc, char **argv) {
+    const struct debounce_config *cfg = debounce_dev->config;
+    struct debounce_data *data = debounce_dev->data;
+
+    for (int i = 0; i < cfg->positions; i++) {
+        shell_print(sh, "%2d: press %2u ms, release %2u ms, %u bounces", i, cfg->press_ms[i],
+                    cfg->release_ms[i], (uint32_t)atomic_get(&data->chatter[i]));
+    }
+
+    return 0;
+}
+
+static int cmd_debounce_reset(const struct shell *sh, size_t argc, char **argv) {
+    const struct debounce_config *cfg = debounce_dev->config;
+    struct debounce_data *data = debounce_dev->data;
+
+    for (int i = 0; i < cfg->positions; i++) {
+        atomic_clear(&data->chatter[i]);
+    }
+
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_debounce,
+                               SHELL_CMD(reset, NULL, "Clear bounce counts", cmd_debounce_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((arixa), debounce, &sub_debounce, "Debounce times and bounces per key position",
+                 cmd_debounce_show, 1, 0);
+
+#endif
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+// Cycle count at the matrix edge the last reported press of a key position came from.
+uint32_t zmk_kscan_debounce_press_cycles(uint32_t position);
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/position_state_changed.h>
+
+#include "power_model.h"
+
+#define PROBE_WINDOW K_SECONDS(30)
+
+// Interrupt mode only scans while a key is down, polling also wakes every poll period with all
+// keys up. CPU time is split by whether any key was held so the two builds can be compared.
+struct held_split {
+    uint64_t ms;
+    uint64_t busy_cycles;
+    uint32_t wakeups;
+};
+
+static struct held_split keys_up, keys_down;
+static struct k_spinlock lock;
+static uint32_t held;
+static int64_t last_ms;
+static uint64_t last_busy_cycles;
+static uint32_t last_wakeups;
+
+static uint64_t cpu_busy_cycles() {
+    k_thread_runtime_stats_t stats;
+
+    k_thread_runtime_stats_all_get(&stats);
+    return stats.total_cycles;
+}
+
+// The matrix driver scans from the system work queue, in polling mode and while a key is down
+// in interrupt mode. Every switch to that thread is counted by the scheduler's usage analysis,
+// so the count includes the scans along with any other work run there, such as BLE and events.
+static uint32_t sys_work_q_wakeups() { return k_sys_work_q.thread.base.usage.num_windows; }
+
+// charges the time since the last call to the current held state, with the lock held
+static void account() {
+    struct held_split *split = held > 0 ? &keys_down : &keys_up;
+    int64_t now = k_uptime_get();
+    uint64_t busy = cpu_busy_cycles();
+    uint32_t wakeups = sys_work_q_wakeups();
+
+    split->ms += now - last_ms;
+    split->busy_cycles += busy - last_busy_cycles;
+    split->wakeups += wakeups - last_wakeups;
+    last_ms = now;
+    last_busy_cycles = busy;
+    last_wakeups = wakeups;
+}
+
+// busy time in permille of the time spent in a state
+static uint32_t busy_permille(const struct held_split *split) {
+    uint64_t cycles = k_ms_to_cyc_floor64(split->ms);
+
+    return cycles > 0 ? MIN(split->busy_cycles * 1000 / cycles, 1000) : 0;
+}
+
+static uint32_t wakeups_per_sec(const struct held_split *split) {
+    return split->ms > 0 ? (uint64_t)split->wakeups * 1000 / split->ms : 0;
+}
+
+// CPU current from the busy time and the power model's typical figures. The matrix draws nothing
+// itself with all keys up, polling only costs the CPU waking to drive and read it.
+static uint32_t cpu_microamps(const struct held_split *split) {
+    return ZMK_POWER_CPU_IDLE_UA +
+           (ZMK_POWER_CPU_ACTIVE_UA - ZMK_POWER_CPU_IDLE_UA) * busy_permille(split) / 1000;
+}
+
+static void report_work_cb(struct k_work *work) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    struct held_split up, down;
+
+    account();
+    up = keys_up;
+    down = keys_down;
+    keys_up = (struct held_split){};
+    keys_down = (struct held_split){};
+    k_spin_unlock(&lock, key);
+
+    LOG_INF("kscan %s: keys up %u wakeups/s cpu %u permille ~%u uA over %u ms, keys down %u "
+            "wakeups/s cpu %u permille ~%u uA over %u ms",
+            IS_ENABLED(CONFIG_ZMK_KSCAN_MATRIX_POLLING) ? "polling" : "interrupts",
+            wakeups_per_sec(&up), busy_permille(&up), cpu_microamps(&up), (uint32_t)up.ms,
+            wakeups_per_sec(&down), busy_permille(&down), cpu_microamps(&down),
+            (uint32_t)down.ms);
+
+    k_work_schedule(k_work_delayable_from_work(work), PROBE_WINDOW);
+}
+
+static K_WORK_DELAYABLE_DEFINE(report_work, report_work_cb);
+
+static int kscan_probe_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    account();
+    if (ev->state) {
+        held++;
+    } else if (held > 0) {
+        held--;
+    }
+
+    k_spin_unlock(&lock, key);
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(kscan_probe, kscan_probe_listener);
+ZMK_SUBSCRIPTION(kscan_probe, zmk_position_state_changed);
+
+static int kscan_probe_init(void) {
+    last_ms = k_uptime_get();
+    last_busy_cycles = cpu_busy_cycles();
+    last_wakeups = sys_work_q_wakeups();
+    k_work_schedule(&report_work, PROBE_WINDOW);
+
+    return 0;
+}
+
+SYS_INIT(kscan_probe_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
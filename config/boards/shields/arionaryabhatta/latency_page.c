@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <stdio.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+
+#include "latency_page.h"
+#include "key_latency.h"
+#include "widgets/latency_status.h"
+
+// One row per stage: its name and average press latency on the upper page, and on the lower one a
+// bar per log2 bucket from 16 us up, faster presses counted in the first, scaled to the row's
+// fullest bucket.
+
+#define DISPLAY_NODE DT_CHOSEN(zephyr_display)
+
+#define ROW_HEIGHT 16
+#define BAR_PITCH 8
+#define BAR_WIDTH 6
+#define FIRST_BUCKET 4
+#define BARS (ZMK_KEY_LATENCY_BUCKETS - FIRST_BUCKET)
+
+#define REFRESH_MS 1000
+
+BUILD_ASSERT(ZMK_KEY_LATENCY_STAGE_COUNT * ROW_HEIGHT <= DT_PROP(DISPLAY_NODE, height),
+             "a row per latency stage must fit on the display");
+BUILD_ASSERT(BARS * BAR_PITCH <= DT_PROP(DISPLAY_NODE, width),
+             "a bar per latency bucket must fit on the display");
+
+static const char *const row_names[ZMK_KEY_LATENCY_STAGE_COUNT] = {
+    [ZMK_KEY_LATENCY_SCAN] = "scan",
+    [ZMK_KEY_LATENCY_BINDING] = "bind",
+    [ZMK_KEY_LATENCY_REPORT] = "report",
+    [ZMK_KEY_LATENCY_TOTAL] = "total",
+};
+
+struct latency_row {
+    lv_obj_t *label;
+    lv_obj_t *bars;
+    struct zmk_key_latency_stats stats; // as last drawn
+};
+
+static struct latency_row rows[ZMK_KEY_LATENCY_STAGE_COUNT];
+static lv_obj_t *page;
+
+// loaded again when the page is toggled off
+static lv_obj_t *status_screen;
+
+static void draw_bars_cb(lv_event_t *e) {
+    const struct latency_row *row = lv_event_get_user_data(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    uint32_t counts[BARS] = {0};
+    uint32_t peak = 0;
+    lv_draw_rect_dsc_t dsc;
+    lv_area_t coords;
+
+    for (int i = 0; i < ZMK_KEY_LATENCY_BUCKETS; i++) {
+        counts[MAX(i - FIRST_BUCKET, 0)] += row->stats.buckets[i];
+    }
+    for (int i = 0; i < BARS; i++) {
+        peak = MAX(peak, counts[i]);
+    }
+    if (peak == 0) {
+        return;
+    }
+
+    lv_obj_get_coords(obj, &coords);
+    lv_draw_rect_dsc_init(&dsc);
+    dsc.bg_color = lv_color_black();
+
+    for (int i = 0; i < BARS; i++) {
+        if (counts[i] == 0) {
+            continue;
+        }
+
+        // a bucket with any press in it gets at least a pixel
+        lv_coord_t height = MAX(counts[i] * lv_area_get_height(&coords) / peak, 1);
+        lv_area_t bar = {
+            .x1 = coords.x1 + i * BAR_PITCH,
+            .y1 = coords.y2 - height + 1,
+            .x2 = coords.x1 + i * BAR_PITCH + BAR_WIDTH - 1,
+            .y2 = coords.y2,
+        };
+
+        lv_draw_rect(lv_event_get_draw_ctx(e), &dsc, &bar);
+    }
+}
+
+static void refresh() {
+    for (int stage = 0; stage < ZMK_KEY_LATENCY_STAGE_COUNT; stage++) {
+        struct latency_row *row = &rows[stage];
+        struct zmk_key_latency_stats stats;
+        char avg[6];
+        char text[14];
+
+        zmk_key_latency_get(stage, &stats);
+        if (stats.count == row->stats.count && stats.total_us == row->stats.total_us) {
+            continue;
+        }
+        row->stats = stats;
+
+        uint32_t avg_us = stats.count > 0 ? stats.total_us / stats.count : 0;
+        latency_status_text(avg, sizeof(avg), (struct latency_status_state){.avg_us = avg_us});
+        snprintf(text, sizeof(text), "%s %s", row_names[stage], stats.count > 0 ? avg : "-");
+        lv_label_set_text(row->label, text);
+        lv_obj_invalidate(row->bars);
+    }
+}
+
+static void refresh_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(refresh_work, refresh_work_cb);
+
+static void refresh_work_cb(struct k_work *work) {
+    if (lv_scr_act() != page) {
+        return;
+    }
+
+    refresh();
+    k_work_schedule_for_queue(zmk_display_work_q(), &refresh_work, K_MSEC(REFRESH_MS));
+}
+
+static void toggle_work_cb(struct k_work *work) {
+    if (lv_scr_act() == page) {
+        lv_scr_load(status_screen);
+        return;
+    }
+
+    status_screen = lv_scr_act();
+    lv_scr_load(page);
+    k_work_reschedule_for_queue(zmk_display_work_q(), &refresh_work, K_NO_WAIT);
+}
+
+static K_WORK_DEFINE(toggle_work, toggle_work_cb);
+
+void zmk_latency_page_toggle() {
+    if (page == NULL || !zmk_display_is_initialized()) {
+        return;
+    }
+
+    k_work_submit_to_queue(zmk_display_work_q(), &toggle_work);
+}
+
+int zmk_latency_page_init(lv_style_t *style) {
+    page = lv_obj_create(NULL);
+    lv_obj_add_style(page, style, LV_PART_MAIN);
+
+    for (int stage = 0; stage < ZMK_KEY_LATENCY_STAGE_COUNT; stage++) {
+        struct latency_row *row = &rows[stage];
+
+        row->label = lv_label_create(page);
+        lv_label_set_text(row->label, row_names[stage]);
+        lv_obj_set_pos(row->label, 0, stage * ROW_HEIGHT);
+
+        row->bars = lv_obj_create(page);
+        lv_obj_remove_style_all(row->bars);
+        lv_obj_set_pos(row->bars, 0, stage * ROW_HEIGHT + ROW_HEIGHT / 2);
+        lv_obj_set_size(row->bars, BARS * BAR_PITCH, ROW_HEIGHT / 2);
+        lv_obj_add_event_cb(row->bars, draw_bars_cb, LV_EVENT_DRAW_MAIN, row);
+    }
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+
+// A second screen with the key latency histograms, shown in place of the status screen.
+int zmk_latency_page_init(lv_style_t *style);
+
+// Shows the page, or the status screen again if the page is showing.
+void zmk_latency_page_toggle();
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/hid.h>
+
+#include "events/explicit_mods_changed.h"
+
+static uint8_t last_modifiers;
+
+static int mods_filter_listener(const zmk_event_t *eh) {
+    // the HID listener has already applied this keycode to the report
+    uint8_t modifiers = zmk_hid_get_explicit_mods();
+
+    if (modifiers == last_modifiers) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+    last_modifiers = modifiers;
+
+    raise_zmk_explicit_mods_changed(
+        (struct zmk_explicit_mods_changed){.modifiers = modifiers, .timestamp = k_uptime_get()});
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(mods_filter, mods_filter_listener);
+ZMK_SUBSCRIPTION(mods_filter, zmk_keycode_state_changed);
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/drivers/i2c.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+#include <zmk/activity.h>
+#include <zmk/usb.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+#include <zmk/events/usb_conn_state_changed.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ARIXA_BATTERY_GAUGE)
+#include "events/battery_gauge_changed.h"
+#endif
+
+#include "oled_theme.h"
+#include "power_model.h"
+
+#define DISPLAY_NODE DT_CHOSEN(zephyr_display)
+#define PANEL_PIXELS (DT_PROP(DISPLAY_NODE, width) * DT_PROP(DISPLAY_NODE, height))
+
+// the polarity the driver sets up at boot, kept while on USB power
+#define BOOT_REVERSED DT_PROP(DISPLAY_NODE, inversion_on)
+
+// the SSD1306 driver has no runtime polarity or charge pump calls, the commands are sent directly
+BUILD_ASSERT(DT_ON_BUS(DISPLAY_NODE, i2c), "the SSD1306 commands are sent over I2C");
+
+#define SSD1306_CONTROL_COMMAND 0x00
+#define SSD1306_SET_NORMAL_DISPLAY 0xA6
+#define SSD1306_SET_REVERSE_DISPLAY 0xA7
+#define SSD1306_DISPLAY_OFF 0xAE
+#define SSD1306_DISPLAY_ON 0xAF
+#define SSD1306_CHARGE_PUMP 0x8D
+#define SSD1306_CHARGE_PUMP_OFF 0x10
+#define SSD1306_CHARGE_PUMP_ON 0x14
+
+// on battery the polarity only flips once the other one lights this many fewer pixels
+#define FLIP_MARGIN (PANEL_PIXELS / 16)
+
+static const struct device *display_dev = DEVICE_DT_GET(DISPLAY_NODE);
+static const struct i2c_dt_spec panel_i2c = I2C_DT_SPEC_GET(DISPLAY_NODE);
+
+static struct zmk_oled_theme_stats stats;
+static struct k_spinlock lock;
+static uint32_t normal_lit;
+static bool initialized;
+
+// written by the event listener, read on the display work queue
+static struct {
+    bool usb_powered;
+    enum zmk_activity_state activity;
+    uint8_t state_of_charge;
+} inputs = {.activity = ZMK_ACTIVITY_ACTIVE, .state_of_charge = 100};
+
+#if IS_ENABLED(CONFIG_ARIXA_OLED_IDLE_STAGES)
+// set on the display work queue once the panel has been dimmed for ARIXA_OLED_OFF_DELAY
+static bool off_delay_expired;
+#endif
+
+static uint32_t lit_pixels(bool reversed) {
+    return reversed ? PANEL_PIXELS - normal_lit : normal_lit;
+}
+
+// The panel is only touched from the display work queue, the lock just keeps stats consistent
+// for the shell.
+
+static int send_commands(const uint8_t *cmd, size_t len) {
+    return i2c_write_dt(&panel_i2c, cmd, len);
+}
+
+static int set_reversed(bool reversed) {
+    uint8_t cmd[] = {SSD1306_CONTROL_COMMAND,
+                     reversed ? SSD1306_SET_REVERSE_DISPLAY : SSD1306_SET_NORMAL_DISPLAY};
+
+    if (reversed == stats.reversed) {
+        return 0;
+    }
+
+    int rc = send_commands(cmd, sizeof(cmd));
+    if (rc == 0) {
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        stats.reversed = reversed;
+        k_spin_unlock(&lock, key);
+    }
+    return rc;
+}
+
+static int set_contrast(uint8_t contrast) {
+    if (contrast == stats.contrast) {
+        return 0;
+    }
+
+    int rc = display_set_contrast(display_dev, contrast);
+    if (rc == 0) {
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        stats.contrast = contrast;
+        k_spin_unlock(&lock, key);
+    }
+    return rc;
+}
+
+// The charge pump goes down with the panel, the datasheet order is display off before pump off
+// and pump on before display on. GDDRAM keeps its content either way, so nothing is redrawn.
+static int set_powered(bool powered) {
+    uint8_t off[] = {SSD1306_CONTROL_COMMAND, SSD1306_DISPLAY_OFF, SSD1306_CHARGE_PUMP,
+                     SSD1306_CHARGE_PUMP_OFF};
+    uint8_t on[] = {SSD1306_CONTROL_COMMAND, SSD1306_CHARGE_PUMP, SSD1306_CHARGE_PUMP_ON,
+                    SSD1306_DISPLAY_ON};
+
+    if (powered == (stats.stage != ZMK_OLED_STAGE_OFF)) {
+        return 0;
+    }
+
+    int rc = powered ? send_commands(on, sizeof(on)) : send_commands(off, sizeof(off));
+
+#if IS_ENABLED(CONFIG_ARIXA_POWER_MODEL)
+    if (rc == 0) {
+        zmk_power_model_set_oled_on(powered);
+    }
+#endif
+    return rc;
+}
+
+#if IS_ENABLED(CONFIG_ARIXA_OLED_IDLE_STAGES) && IS_ENABLED(CONFIG_ZMK_DISPLAY_BLANK_ON_IDLE)
+// ZMK blanks the panel and stops its refresh timer when the keyboard goes idle. Its listener is
+// subscribed as "display", which sorts ahead of "oled_theme", so its blanking work is queued before
+// ours and the panel can be switched back on here for the dimmed stage.
+static int unblank_dimmed() {
+    uint8_t on[] = {SSD1306_CONTROL_COMMAND, SSD1306_DISPLAY_ON};
+
+    return send_commands(on, sizeof(on));
+}
+#endif
+
+static enum zmk_oled_stage choose_stage() {
+#if IS_ENABLED(CONFIG_ARIXA_OLED_IDLE_STAGES)
+    switch (inputs.activity) {
+    case ZMK_ACTIVITY_ACTIVE:
+        off_delay_expired = false;
+        return ZMK_OLED_STAGE_ON;
+    case ZMK_ACTIVITY_IDLE:
+        return off_delay_expired ? ZMK_OLED_STAGE_OFF : ZMK_OLED_STAGE_DIM;
+    default:
+        // the panel stays powered through system off, leave it dark
+        return ZMK_OLED_STAGE_OFF;
+    }
+#else
+    return ZMK_OLED_STAGE_ON;
+#endif
+}
+
+static bool choose_reversed() {
+#if IS_ENABLED(CONFIG_ARIXA_OLED_THEME_AUTO)
+    if (inputs.usb_powered) {
+        return BOOT_REVERSED;
+    }
+
+    // nothing is known about the content until the first counted frame
+    if (stats.frames == 0) {
+        return stats.reversed;
+    }
+
+    // on battery whichever polarity lights fewer pixels, with some margin against flicker
+    return lit_pixels(!stats.reversed) + FLIP_MARGIN < lit_pixels(stats.reversed)
+               ? !stats.reversed
+               : stats.reversed;
+#else
+    return BOOT_REVERSED;
+#endif
+}
+
+static uint8_t choose_contrast(enum zmk_oled_stage stage) {
+#if IS_ENABLED(CONFIG_ARIXA_OLED_IDLE_STAGES)
+    if (stage != ZMK_OLED_STAGE_ON) {
+        return CONFIG_ARIXA_OLED_IDLE_CONTRAST;
+    }
+#endif
+
+#if IS_ENABLED(CONFIG_ARIXA_OLED_THEME_AUTO)
+    if (inputs.usb_powered) {
+        return CONFIG_ARIXA_OLED_THEME_CONTRAST_USB;
+    }
+    if (inputs.state_of_charge <= CONFIG_ARIXA_OLED_THEME_LOW_SOC) {
+        return CONFIG_ARIXA_OLED_THEME_CONTRAST_LOW;
+    }
+    return CONFIG_ARIXA_OLED_THEME_CONTRAST_BATTERY;
+#else
+    return CONFIG_SSD1306_DEFAULT_CONTRAST;
+#endif
+}
+
+static void apply() {
+    enum zmk_oled_stage stage = choose_stage();
+    int rc = 0;
+
+    // powering down goes first, waking up last so the first lit frame already has its contrast
+    if (stage == ZMK_OLED_STAGE_OFF) {
+        rc = set_powered(false);
+    }
+    if (rc == 0) {
+        rc = set_reversed(choose_reversed());
+    }
+    if (rc == 0) {
+        rc = set_contrast(choose_contrast(stage));
+    }
+    if (rc == 0 && stage != ZMK_OLED_STAGE_OFF) {
+        rc = set_powered(true);
+    }
+#if IS_ENABLED(CONFIG_ARIXA_OLED_IDLE_STAGES) && IS_ENABLED(CONFIG_ZMK_DISPLAY_BLANK_ON_IDLE)
+    if (rc == 0 && stage == ZMK_OLED_STAGE_DIM && stats.stage != ZMK_OLED_STAGE_DIM) {
+        rc = unblank_dimmed();
+    }
+#endif
+
+    if (rc != 0) {
+        LOG_WRN("failed to apply the OLED theme: %d", rc);
+        return;
+    }
+
+    if (stage != stats.stage) {
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        stats.stage = stage;
+        k_spin_unlock(&lock, key);
+    }
+}
+
+static void report_lit_pixels() {
+#if IS_ENABLED(CONFIG_ARIXA_POWER_MODEL)
+    zmk_power_model_set_lit_pixels(lit_pixels(stats.reversed));
+#endif
+}
+
+void zmk_oled_theme_frame(uint32_t normal_lit_pixels) {
+    normal_lit = normal_lit_pixels;
+    if (initialized) {
+        apply();
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    stats.frames++;
+    stats.lit_pixels = lit_pixels(stats.reversed);
+    stats.lit_total += stats.lit_pixels;
+    stats.lit_total_boot += lit_pixels(BOOT_REVERSED);
+    k_spin_unlock(&lock, key);
+
+    report_lit_pixels();
+}
+
+void zmk_oled_theme_get_stats(struct zmk_oled_theme_stats *out) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    *out = stats;
+    k_spin_unlock(&lock, key);
+}
+
+static void apply_work_cb(struct k_work *work) {
+    apply();
+    report_lit_pixels();
+}
+
+static K_WORK_DEFINE(apply_work, apply_work_cb);
+
+#if IS_ENABLED(CONFIG_ARIXA_OLED_IDLE_STAGES)
+static void off_delay_work_cb(struct k_work *work) {
+    off_delay_expired = true;
+    apply();
+}
+
+static K_WORK_DELAYABLE_DEFINE(off_delay_work, off_delay_work_cb);
+#endif
+
+static int oled_theme_listener(const zmk_event_t *eh) {
+    const struct zmk_activity_state_changed *activity = as_zmk_activity_state_changed(eh);
+
+    if (activity != NULL) {
+        inputs.activity = activity->state;
+
+#if IS_ENABLED(CONFIG_ARIXA_OLED_IDLE_STAGES)
+        // a late expiry is harmless, the stage is picked from the activity state again
+        if (activity->state == ZMK_ACTIVITY_IDLE) {
+            k_work_reschedule_for_queue(zmk_display_work_q(), &off_delay_work,
+                                        K_SECONDS(CONFIG_ARIXA_OLED_OFF_DELAY));
+        } else {
+            k_work_cancel_delayable(&off_delay_work);
+        }
+
+        // system off follows right away, before the display work queue would get to run
+        if (activity->state == ZMK_ACTIVITY_SLEEP && initialized) {
+            set_powered(false);
+        }
+#endif
+    }
+
+#if IS_ENABLED(CONFIG_ARIXA_BATTERY_GAUGE)
+    const struct zmk_battery_gauge_changed *gauge = as_zmk_battery_gauge_changed(eh);
+
+    if (gauge != NULL) {
+        inputs.state_of_charge = gauge->state.state_of_charge;
+    }
+#endif
+
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+    inputs.usb_powered = zmk_usb_is_powered();
+#endif
+
+    if (initialized) {
+        k_work_submit_to_queue(zmk_display_work_q(), &apply_work);
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(oled_theme, oled_theme_listener);
+ZMK_SUBSCRIPTION(oled_theme, zmk_activity_state_changed);
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+ZMK_SUBSCRIPTION(oled_theme, zmk_usb_conn_state_changed);
+#endif
+#if IS_ENABLED(CONFIG_ARIXA_BATTERY_GAUGE)
+ZMK_SUBSCRIPTION(oled_theme, zmk_battery_gauge_changed);
+#endif
+
+int zmk_oled_theme_init() {
+    if (!device_is_ready(display_dev) || !i2c_is_ready_dt(&panel_i2c)) {
+        return -ENODEV;
+    }
+
+    // what the driver has programmed at boot
+    stats.stage = ZMK_OLED_STAGE_ON;
+    stats.reversed = BOOT_REVERSED;
+    stats.contrast = CONFIG_SSD1306_DEFAULT_CONTRAST;
+
+#if IS_ENABLED(CONFIG_USB_DEVICE_STACK)
+    inputs.usb_powered = zmk_usb_is_powered();
+#endif
+#if IS_ENABLED(CONFIG_ARIXA_BATTERY_GAUGE)
+    inputs.state_of_charge = zmk_battery_gauge_get_state().state_of_charge;
+#endif
+
+    initialized = true;
+    k_work_submit_to_queue(zmk_display_work_q(), &apply_work);
+
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+static const char *const stage_names[] = {
+    [ZMK_OLED_STAGE_ON] = "on",
+    [ZMK_OLED_STAGE_DIM] = "dimmed",
+    [ZMK_OLED_STAGE_OFF] = "off",
+};
+
+static int cmd_theme_show(const struct shell *sh, size_t argc, char **argv) {
+    struct zmk_oled_theme_stats now;
+
+    zmk_oled_theme_get_stats(&now);
+
+    shell_print(sh, "%s, %s, contrast %u, %s, %u%%", stage_names[now.stage],
+                now.reversed ? "reversed" : "normal", now.contrast,
+                inputs.usb_powered ? "usb" : "battery", inputs.state_of_charge);
+
+    if (now.frames == 0) {
+        return 0;
+    }
+
+    shell_print(sh, "%u frames, %u px lit now, avg %u px per frame, boot polarity avg %u px",
+                now.frames, now.lit_pixels, (uint32_t)(now.lit_total / now.frames),
+                (uint32_t)(now.lit_total_boot / now.frames));
+
+    return 0;
+}
+
+SHELL_SUBCMD_ADD((arixa), theme, NULL, "OLED stage, polarity, contrast and lit pixels",
+                 cmd_theme_show, 1, 0);
+
+#endif
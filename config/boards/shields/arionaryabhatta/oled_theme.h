@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+enum zmk_oled_stage {
+    ZMK_OLED_STAGE_ON,
+    ZMK_OLED_STAGE_DIM, // idle, at ARIXA_OLED_IDLE_CONTRAST
+    ZMK_OLED_STAGE_OFF, // display and charge pump off, GDDRAM kept
+};
+
+struct zmk_oled_theme_stats {
+    enum zmk_oled_stage stage;
+    bool reversed;
+    uint8_t contrast;
+    uint32_t frames;
+    uint32_t lit_pixels;       // lit by the last frame
+    uint64_t lit_total;        // summed over all frames
+    uint64_t lit_total_boot;   // what the devicetree polarity would have lit over them
+};
+
+int zmk_oled_theme_init();
+
+// Called from the display work queue after every write to the panel, with the number of pixels
+// the panel content lights in normal, not reverse, display mode.
+void zmk_oled_theme_frame(uint32_t normal_lit_pixels);
+
+void zmk_oled_theme_get_stats(struct zmk_oled_theme_stats *out);
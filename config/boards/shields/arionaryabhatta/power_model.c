@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/init.h>
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/activity.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+#include <zephyr/bluetooth/conn.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW)
+#include <zmk/rgb_underglow.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW_EXT_POWER)
+#include <drivers/ext_power.h>
+#endif
+
+#include "power_model.h"
+#include "events/power_estimate_changed.h"
+
+// Typical figures from the nRF52840, SSD1306 and WS2812B datasheets at 3.7 V, the CPU's are in
+// power_model.h. They are an estimate to compare subsystems by, not a measurement.
+#define RADIO_CONN_EVENT_UAMS 8000 // one 0 dBm connection event, ramp up included
+#define RADIO_ADV_EVENT_UAMS 20000 // one connectable advertising event on three channels
+#define RADIO_ADV_EVENTS_PER_SEC 8 // ZMK advertises at 100 to 150 ms
+#define OLED_ON_UA 400         // controller and charge pump with nothing lit
+#define OLED_PIXEL_NA 2400     // each lit pixel at the default contrast
+#define OLED_OFF_UA 10         // display sleep
+#define LED_QUIESCENT_UA 700   // a powered WS2812B showing black
+#define LED_CHANNEL_UA 12000   // one of its three channels fully on
+
+#if IS_ENABLED(CONFIG_ZMK_DISPLAY)
+#define OLED_PIXELS                                                                                \
+    (DT_PROP(DT_CHOSEN(zephyr_display), width) * DT_PROP(DT_CHOSEN(zephyr_display), height))
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW)
+#define UNDERGLOW_LEDS DT_PROP(DT_CHOSEN(zmk_underglow), chain_length)
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW_EXT_POWER)
+static const struct device *const ext_power = DEVICE_DT_GET_ANY(zmk_ext_power_generic);
+#endif
+
+static struct k_spinlock lock;
+
+// the current accounting window
+static int64_t window_start;
+static uint64_t window_cpu_cycles;
+static atomic_t window_reports;
+static uint64_t window_lit_pxms; // lit pixels times the ms they were lit
+static uint32_t window_oled_on_ms;
+
+// the panel, kept current by the zmk_power_model_set_* calls and activity changes
+static uint32_t lit_pixels;
+static bool oled_on = true;
+static int64_t oled_since;
+
+static struct {
+    uint64_t charge_uams[ZMK_POWER_SUBSYSTEM_COUNT];
+    uint64_t elapsed_ms;
+    uint64_t cpu_active_ms;
+    uint64_t oled_on_ms;
+    uint64_t oled_lit_pxms;
+    uint64_t underglow_on_ms;
+    uint32_t radio_events;
+} totals;
+
+static struct zmk_power_estimate estimate;
+static uint32_t raised_total;
+
+static const char *const subsystem_names[ZMK_POWER_SUBSYSTEM_COUNT] = {
+    [ZMK_POWER_CPU] = "cpu",
+    [ZMK_POWER_RADIO] = "radio",
+    [ZMK_POWER_OLED] = "oled",
+    [ZMK_POWER_UNDERGLOW] = "underglow",
+};
+
+const char *zmk_power_subsystem_name(enum zmk_power_subsystem subsystem) {
+    return subsystem_names[subsystem];
+}
+
+// brings the panel accounting up to now, with the lock held
+static void note_oled(int64_t now) {
+    if (oled_on) {
+        window_oled_on_ms += now - oled_since;
+        window_lit_pxms += (uint64_t)lit_pixels * (now - oled_since);
+    }
+    oled_since = now;
+}
+
+void zmk_power_model_set_lit_pixels(uint32_t pixels) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    note_oled(k_uptime_get());
+    lit_pixels = pixels;
+
+    k_spin_unlock(&lock, key);
+}
+
+void zmk_power_model_set_oled_on(bool on) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    note_oled(k_uptime_get());
+    oled_on = on;
+
+    k_spin_unlock(&lock, key);
+}
+
+static uint64_t cpu_busy_cycles() {
+    k_thread_runtime_stats_t stats;
+
+    k_thread_runtime_stats_all_get(&stats);
+    return stats.total_cycles;
+}
+
+static uint64_t cpu_charge(uint32_t window_ms, uint32_t *active_ms) {
+    uint64_t busy = cpu_busy_cycles();
+    uint64_t window_cycles = MAX(k_ms_to_cyc_floor64(window_ms), 1);
+    uint64_t active_cycles = MIN(busy - window_cpu_cycles, window_cycles);
+
+    window_cpu_cycles = busy;
+    *active_ms = active_cycles * window_ms / window_cycles;
+
+    return (uint64_t)ZMK_POWER_CPU_IDLE_UA * window_ms +
+           (uint64_t)(ZMK_POWER_CPU_ACTIVE_UA - ZMK_POWER_CPU_IDLE_UA) * *active_ms;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+struct radio_window {
+    uint32_t ms;
+    uint32_t events;
+    bool connected;
+};
+
+static void count_conn_events(struct bt_conn *conn, void *data) {
+    struct radio_window *window = data;
+    struct bt_conn_info info;
+
+    if (bt_conn_get_info(conn, &info) != 0 || info.state != BT_CONN_STATE_CONNECTED) {
+        return;
+    }
+
+    // with nothing to send the peripheral sleeps through up to latency events
+    window->events += window->ms * 4 / (info.le.interval * 5 * (info.le.latency + 1));
+    window->connected = true;
+}
+#endif
+
+static uint64_t radio_charge(uint32_t window_ms, uint32_t reports, uint32_t *events) {
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    struct radio_window window = {.ms = window_ms};
+
+    bt_conn_foreach(BT_CONN_TYPE_LE, count_conn_events, &window);
+    if (!window.connected) {
+        *events = window_ms * RADIO_ADV_EVENTS_PER_SEC / 1000;
+        return (uint64_t)*events * RADIO_ADV_EVENT_UAMS;
+    }
+
+    // every report goes out on an event the latency would have skipped
+    *events = window.events + reports;
+    return (uint64_t)*events * RADIO_CONN_EVENT_UAMS;
+#else
+    *events = 0;
+    return 0;
+#endif
+}
+
+static uint64_t oled_charge(uint32_t window_ms, uint32_t on_ms, uint64_t lit_pxms) {
+#if IS_ENABLED(CONFIG_ZMK_DISPLAY)
+    return (uint64_t)OLED_OFF_UA * (window_ms - on_ms) + (uint64_t)OLED_ON_UA * on_ms +
+           lit_pxms * OLED_PIXEL_NA / 1000;
+#else
+    return 0;
+#endif
+}
+
+static uint64_t underglow_charge(uint32_t window_ms, bool *on) {
+    *on = false;
+
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW)
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW_EXT_POWER)
+    if (ext_power != NULL && ext_power_get(ext_power) <= 0) {
+        return 0;
+    }
+#endif
+
+    uint32_t led_ua = LED_QUIESCENT_UA;
+
+    zmk_rgb_underglow_get_state(on);
+    if (*on) {
+        struct zmk_led_hsb hsb = zmk_rgb_underglow_calc_brt(0);
+        uint32_t b = CONFIG_ZMK_RGB_UNDERGLOW_BRT_MIN +
+                     (CONFIG_ZMK_RGB_UNDERGLOW_BRT_MAX - CONFIG_ZMK_RGB_UNDERGLOW_BRT_MIN) *
+                         hsb.b / 100;
+
+        // a saturated hue lights one to two channels, white all three
+        led_ua += LED_CHANNEL_UA * b * (300 - 150 * hsb.s / 100) / 10000;
+    }
+
+    return (uint64_t)led_ua * UNDERGLOW_LEDS * window_ms;
+#else
+    return 0;
+#endif
+}
+
+// closes the current accounting window and starts the next one
+static void update() {
+    uint64_t charge[ZMK_POWER_SUBSYSTEM_COUNT];
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    int64_t now = k_uptime_get();
+    uint32_t window_ms = now - window_start;
+    uint32_t on_ms, cpu_active_ms, radio_events;
+    uint64_t lit_pxms;
+    bool underglow_on;
+
+    if (window_ms == 0) {
+        k_spin_unlock(&lock, key);
+        return;
+    }
+
+    note_oled(now);
+    on_ms = window_oled_on_ms;
+    lit_pxms = window_lit_pxms;
+    window_oled_on_ms = 0;
+    window_lit_pxms = 0;
+    window_start = now;
+    k_spin_unlock(&lock, key);
+
+    charge[ZMK_POWER_CPU] = cpu_charge(window_ms, &cpu_active_ms);
+    charge[ZMK_POWER_RADIO] =
+        radio_charge(window_ms, atomic_clear(&window_reports), &radio_events);
+    charge[ZMK_POWER_OLED] = oled_charge(window_ms, on_ms, lit_pxms);
+    charge[ZMK_POWER_UNDERGLOW] = underglow_charge(window_ms, &underglow_on);
+
+    key = k_spin_lock(&lock);
+    estimate.total_microamps = 0;
+    for (int i = 0; i < ZMK_POWER_SUBSYSTEM_COUNT; i++) {
+        estimate.microamps[i] = charge[i] / window_ms;
+        estimate.total_microamps += estimate.microamps[i];
+        totals.charge_uams[i] += charge[i];
+    }
+
+    totals.elapsed_ms += window_ms;
+    totals.cpu_active_ms += cpu_active_ms;
+    totals.oled_on_ms += on_ms;
+    totals.oled_lit_pxms += lit_pxms;
+    totals.underglow_on_ms += underglow_on ? window_ms : 0;
+    totals.radio_events += radio_events;
+    k_spin_unlock(&lock, key);
+
+    // the status widget shows tenths of a mA
+    if (estimate.total_microamps / 100 != raised_total / 100) {
+        raised_total = estimate.total_microamps;
+        raise_zmk_power_estimate_changed(
+            (struct zmk_power_estimate_changed){.estimate = estimate});
+    }
+}
+
+static void update_work_cb(struct k_work *work) {
+    update();
+
+    // idle windows are closed by the next activity change, nothing polls while idle
+    if (zmk_activity_get_state() == ZMK_ACTIVITY_ACTIVE) {
+        k_work_schedule(k_work_delayable_from_work(work),
+                        K_SECONDS(CONFIG_ARIXA_POWER_MODEL_INTERVAL));
+    }
+}
+
+static K_WORK_DELAYABLE_DEFINE(update_work, update_work_cb);
+
+struct zmk_power_estimate zmk_power_model_get_estimate() {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    struct zmk_power_estimate out = estimate;
+
+    k_spin_unlock(&lock, key);
+    return out;
+}
+
+static uint32_t permille(uint64_t part, uint64_t whole) {
+    return whole > 0 ? part * 1000 / whole : 0;
+}
+
+void zmk_power_model_get_usage(struct zmk_power_usage *out) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    for (int i = 0; i < ZMK_POWER_SUBSYSTEM_COUNT; i++) {
+        out->charge_uas[i] = totals.charge_uams[i] / 1000;
+    }
+
+    out->elapsed_ms = totals.elapsed_ms;
+    out->cpu_active_permille = permille(totals.cpu_active_ms, totals.elapsed_ms);
+    out->oled_on_permille = permille(totals.oled_on_ms, totals.elapsed_ms);
+    out->oled_lit_pixels = totals.oled_on_ms > 0 ? totals.oled_lit_pxms / totals.oled_on_ms : 0;
+    out->underglow_on_permille = permille(totals.underglow_on_ms, totals.elapsed_ms);
+    out->radio_events = totals.radio_events;
+
+    k_spin_unlock(&lock, key);
+}
+
+// the window in progress still counts, it is closed by the next update
+void zmk_power_model_reset() {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    memset(&totals, 0, sizeof(totals));
+    k_spin_unlock(&lock, key);
+}
+
+static int power_model_listener(const zmk_event_t *eh) {
+    const struct zmk_activity_state_changed *ev = as_zmk_activity_state_changed(eh);
+
+    if (ev == NULL) {
+        atomic_inc(&window_reports);
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    // the OLED idle stages report the panel power themselves, it stays lit while dimmed
+#if IS_ENABLED(CONFIG_ZMK_DISPLAY_BLANK_ON_IDLE) && !IS_ENABLED(CONFIG_ARIXA_OLED_IDLE_STAGES)
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    // ZMK blanks the panel whenever the keyboard is not active
+    note_oled(k_uptime_get());
+    oled_on = ev->state == ZMK_ACTIVITY_ACTIVE;
+
+    k_spin_unlock(&lock, key);
+#endif
+
+    k_work_reschedule(&update_work, K_NO_WAIT);
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+ZMK_LISTENER(power_model, power_model_listener);
+ZMK_SUBSCRIPTION(power_model, zmk_activity_state_changed);
+ZMK_SUBSCRIPTION(power_model, zmk_keycode_state_changed);
+
+static int power_model_init(void) {
+#if IS_ENABLED(CONFIG_ZMK_DISPLAY)
+    // until the first flush reports, assume an eighth of the panel is lit
+    lit_pixels = OLED_PIXELS / 8;
+#endif
+
+    window_start = k_uptime_get();
+    oled_since = window_start;
+    window_cpu_cycles = cpu_busy_cycles();
+
+    k_work_schedule(&update_work, K_SECONDS(CONFIG_ARIXA_POWER_MODEL_INTERVAL));
+
+    return 0;
+}
+
+SYS_INIT(power_model_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+#define MA(ua) (ua) / 1000, ((ua) % 1000) / 10
+
+static int cmd_power_show(const struct shell *sh, size_t argc, char **argv) {
+    struct zmk_power_estimate now = zmk_power_model_get_estimate();
+    struct zmk_power_usage usage;
+    uint64_t total_uas = 0;
+
+    zmk_power_model_get_usage(&usage);
+
+    for (int i = 0; i < ZMK_POWER_SUBSYSTEM_COUNT; i++) {
+        uint32_t avg_ua = usage.elapsed_ms > 0 ? usage.charge_uas[i] * 1000 / usage.elapsed_ms : 0;
+
+        shell_print(sh, "%-10s %u.%02u mA now, %u.%02u mA avg, %llu uAh", subsystem_names[i],
+                    MA(now.microamps[i]), MA(avg_ua), usage.charge_uas[i] / 3600);
+        total_uas += usage.charge_uas[i];
+    }
+
+    shell_print(sh, "%-10s %u.%02u mA now, %llu uAh over %u s", "total", MA(now.total_microamps),
+                total_uas / 3600, usage.elapsed_ms / 1000);
+    shell_print(sh, "cpu active %u.%u%%, oled on %u.%u%% with %u px lit, underglow on %u.%u%%, "
+                    "%u radio events",
+                usage.cpu_active_permille / 10, usage.cpu_active_permille % 10,
+                usage.oled_on_permille / 10, usage.oled_on_permille % 10, usage.oled_lit_pixels,
+                usage.underglow_on_permille / 10, usage.underglow_on_permille % 10,
+                usage.radio_events);
+
+    return 0;
+}
+
+static int cmd_power_reset(const struct shell *sh, size_t argc, char **argv) {
+    zmk_power_model_reset();
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_power,
+                               SHELL_CMD(reset, NULL, "Clear accumulated usage", cmd_power_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((arixa), power, &sub_power, "Estimated current per subsystem", cmd_power_show,
+                 1, 0);
+
+#endif
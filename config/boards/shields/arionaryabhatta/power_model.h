@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+// Typical nRF52840 figures at 3.7 V, also used by the kscan probe to estimate the current of the
+// CPU time it measures.
+#define ZMK_POWER_CPU_ACTIVE_UA 3000 // 64 MHz running from flash
+#define ZMK_POWER_CPU_IDLE_UA 5      // System ON idle with the RTC running
+
+enum zmk_power_subsystem {
+    ZMK_POWER_CPU,
+    ZMK_POWER_RADIO,
+    ZMK_POWER_OLED,
+    ZMK_POWER_UNDERGLOW,
+    ZMK_POWER_SUBSYSTEM_COUNT
+};
+
+struct zmk_power_estimate {
+    uint32_t microamps[ZMK_POWER_SUBSYSTEM_COUNT]; // average over the last accounting window
+    uint32_t total_microamps;
+};
+
+struct zmk_power_usage {
+    uint64_t charge_uas[ZMK_POWER_SUBSYSTEM_COUNT]; // microamp seconds since the last reset
+    uint32_t elapsed_ms;
+    uint32_t cpu_active_permille;  // time the CPU was not idle
+    uint32_t oled_on_permille;     // time the panel was not blanked
+    uint32_t oled_lit_pixels;      // average over the time it was on
+    uint32_t underglow_on_permille;
+    uint32_t radio_events;         // connection and advertising events
+};
+
+const char *zmk_power_subsystem_name(enum zmk_power_subsystem subsystem);
+struct zmk_power_estimate zmk_power_model_get_estimate();
+void zmk_power_model_get_usage(struct zmk_power_usage *out);
+void zmk_power_model_reset();
+
+// Called by whatever writes the panel, with the number of pixels it now has lit.
+void zmk_power_model_set_lit_pixels(uint32_t pixels);
+
+// Called by whatever switches the panel off other than ZMK's blanking on idle.
+void zmk_power_model_set_oled_on(bool on);
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT arixa_qdec_encoder
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/pm/device.h>
+#include <stdlib.h>
+#include <soc.h>
+#include <hal/nrf_qdec.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define FULL_ROTATION 360
+
+// REPORTRDY moves ACC to ACCREAD through the short and the interrupt only adds it to the steps
+// waiting for a fetch. Keymap events must not be raised from the ISR, so the trigger handler runs
+// on the system work queue, as it did with the alps,ec11 global thread trigger.
+
+struct qdec_config {
+    NRF_QDEC_Type *reg;
+    struct gpio_dt_spec a;
+    struct gpio_dt_spec b;
+    uint32_t psel_a;
+    uint32_t psel_b;
+    uint16_t steps;
+    nrf_qdec_sampleper_t sampleper;
+    nrf_qdec_reportper_t reportper;
+    bool debounce_filter;
+};
+
+struct qdec_data {
+    const struct device *dev;
+    struct k_spinlock lock;
+    int32_t pending; // steps since the last fetch
+    int32_t fetched; // steps the last fetch took
+    sensor_trigger_handler_t handler;
+    const struct sensor_trigger *trigger;
+    struct k_work trigger_work;
+    // since boot or "arixa encoder reset"
+    atomic_t steps;
+    atomic_t doubles; // samples where both phases changed, their step was dropped
+    atomic_t reports;
+};
+
+static void qdec_isr(const struct device *dev) {
+    const struct qdec_config *cfg = dev->config;
+    struct qdec_data *data = dev->data;
+
+    if (!nrf_qdec_event_check(cfg->reg, NRF_QDEC_EVENT_REPORTRDY)) {
+        return;
+    }
+    nrf_qdec_event_clear(cfg->reg, NRF_QDEC_EVENT_REPORTRDY);
+
+    int32_t acc = nrf_qdec_accread_get(cfg->reg);
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    data->pending += acc;
+    k_spin_unlock(&data->lock, key);
+
+    atomic_add(&data->steps, abs(acc));
+    atomic_add(&data->doubles, nrf_qdec_accdblread_get(cfg->reg));
+    atomic_inc(&data->reports);
+
+    if (data->handler != NULL) {
+        k_work_submit(&data->trigger_work);
+    }
+}
+
+static void trigger_work_cb(struct k_work *work) {
+    struct qdec_data *data = CONTAINER_OF(work, struct qdec_data, trigger_work);
+
+    data->handler(data->dev, data->trigger);
+}
+
+static int qdec_sample_fetch(const struct device *dev, enum sensor_channel chan) {
+    struct qdec_data *data = dev->data;
+
+    if (chan != SENSOR_CHAN_ALL && chan != SENSOR_CHAN_ROTATION) {
+        return -ENOTSUP;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    data->fetched = data->pending;
+    data->pending = 0;
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+static int qdec_channel_get(const struct device *dev, enum sensor_channel chan,
+                            struct sensor_value *val) {
+    const struct qdec_config *cfg = dev->config;
+    struct qdec_data *data = dev->data;
+    int32_t degrees = data->fetched * FULL_ROTATION;
+
+    if (chan != SENSOR_CHAN_ROTATION) {
+        return -ENOTSUP;
+    }
+
+    // the remainder keeps a step that is not a whole degree for the sensor behavior to carry
+    val->val1 = degrees / cfg->steps;
+    val->val2 = (degrees % cfg->steps) * 1000000 / cfg->steps;
+    return 0;
+}
+
+static int qdec_trigger_set(const struct device *dev, const struct sensor_trigger *trig,
+                            sensor_trigger_handler_t handler) {
+    struct qdec_data *data = dev->data;
+
+    if (trig->type != SENSOR_TRIG_DATA_READY) {
+        return -ENOTSUP;
+    }
+
+    data->trigger = trig;
+    data->handler = handler;
+    return 0;
+}
+
+static const struct sensor_driver_api qdec_api = {
+    .sample_fetch = qdec_sample_fetch,
+    .channel_get = qdec_channel_get,
+    .trigger_set = qdec_trigger_set,
+};
+
+static int qdec_pins(const struct qdec_config *cfg, gpio_flags_t flags) {
+    int err = gpio_pin_configure_dt(&cfg->a, flags);
+
+    return err != 0 ? err : gpio_pin_configure_dt(&cfg->b, flags);
+}
+
+static void qdec_start(const struct qdec_config *cfg) {
+    nrf_qdec_enable(cfg->reg);
+    nrf_qdec_task_trigger(cfg->reg, NRF_QDEC_TASK_START);
+}
+
+static void qdec_stop(const struct qdec_config *cfg) {
+    nrf_qdec_task_trigger(cfg->reg, NRF_QDEC_TASK_STOP);
+    nrf_qdec_disable(cfg->reg);
+}
+
+static int qdec_setup(const struct device *dev) {
+    const struct qdec_config *cfg = dev->config;
+    struct qdec_data *data = dev->data;
+
+    if (!gpio_is_ready_dt(&cfg->a) || !gpio_is_ready_dt(&cfg->b)) {
+        return -ENODEV;
+    }
+
+    int err = qdec_pins(cfg, GPIO_INPUT);
+    if (err != 0) {
+        return err;
+    }
+
+    data->dev = dev;
+    k_work_init(&data->trigger_work, trigger_work_cb);
+
+    nrf_qdec_pins_set(cfg->reg, cfg->psel_a, cfg->psel_b, NRF_QDEC_LED_NOT_CONNECTED);
+    nrf_qdec_sampleper_set(cfg->reg, cfg->sampleper);
+    nrf_qdec_reportper_set(cfg->reg, cfg->reportper);
+    if (cfg->debounce_filter) {
+        nrf_qdec_dbfen_enable(cfg->reg);
+    } else {
+        nrf_qdec_dbfen_disable(cfg->reg);
+    }
+    nrf_qdec_shorts_enable(cfg->reg, NRF_QDEC_SHORT_REPORTRDY_READCLRACC_MASK);
+    nrf_qdec_int_enable(cfg->reg, NRF_QDEC_INT_REPORTRDY_MASK);
+
+    qdec_start(cfg);
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_PM_DEVICE)
+
+// the pulls would otherwise hold current through a contact left closed
+static int qdec_pm_action(const struct device *dev, enum pm_device_action action) {
+    const struct qdec_config *cfg = dev->config;
+
+    switch (action) {
+    case PM_DEVICE_ACTION_SUSPEND:
+        qdec_stop(cfg);
+        return qdec_pins(cfg, GPIO_DISCONNECTED);
+    case PM_DEVICE_ACTION_RESUME: {
+        int err = qdec_pins(cfg, GPIO_INPUT);
+        if (err == 0) {
+            qdec_start(cfg);
+        }
+        return err;
+    }
+    default:
+        return -ENOTSUP;
+    }
+}
+
+#endif
+
+#define QDEC_ENCODER_INST(n)                                                                       \
+    BUILD_ASSERT(DT_INST_PROP(n, steps) > 0, "steps must be positive");                            \
+                                                                                                   \
+    static struct qdec_data qdec_data_##n;                                                         \
+                                                                                                   \
+    static const struct qdec_config qdec_config_##n = {                                            \
+        .reg = (NRF_QDEC_Type *)DT_INST_REG_ADDR(n),                                               \
+        .a = GPIO_DT_SPEC_INST_GET(n, a_gpios),                                                    \
+        .b = GPIO_DT_SPEC_INST_GET(n, b_gpios),                                                    \
+        .psel_a = NRF_DT_GPIOS_TO_PSEL(DT_DRV_INST(n), a_gpios),                                   \
+        .psel_b = NRF_DT_GPIOS_TO_PSEL(DT_DRV_INST(n), b_gpios),                                   \
+        .steps = DT_INST_PROP(n, steps),                                                           \
+        /* both enums list the register values in order */                                         \
+        .sampleper = (nrf_qdec_sampleper_t)DT_INST_ENUM_IDX(n, sample_period_us),                  \
+        .reportper = (nrf_qdec_reportper_t)DT_INST_ENUM_IDX(n, report_samples),                    \
+        .debounce_filter = DT_INST_PROP(n, debounce_filter),                                       \
+    };                                                                                             \
+                                                                                                   \
+    static int qdec_init_##n(const struct device *dev) {                                           \
+        IRQ_CONNECT(DT_INST_IRQN(n), DT_INST_IRQ(n, priority), qdec_isr, DEVICE_DT_INST_GET(n),    \
+                    0);                                                                            \
+        irq_enable(DT_INST_IRQN(n));                                                               \
+        return qdec_setup(dev);                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    PM_DEVICE_DT_INST_DEFINE(n, qdec_pm_action);                                                   \
+                                                                                                   \
+    SENSOR_DEVICE_DT_INST_DEFINE(n, qdec_init_##n, PM_DEVICE_DT_INST_GET(n), &qdec_data_##n,       \
+                                 &qdec_config_##n, POST_KERNEL, CONFIG_SENSOR_INIT_PRIORITY,       \
+                                 &qdec_api);
+
+DT_INST_FOREACH_STATUS_OKAY(QDEC_ENCODER_INST)
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+
+static const struct device *const qdec_dev = DEVICE_DT_GET(DT_DRV_INST(0));
+
+static int cmd_encoder_show(const struct shell *sh, size_t argc, char **argv) {
+    const struct qdec_config *cfg = qdec_dev->config;
+    struct qdec_data *data = qdec_dev->data;
+
+    shell_print(sh, "%u steps of %u per rotation in %u reports, %u dropped as double steps",
+                (uint32_t)atomic_get(&data->steps), cfg->steps,
+                (uint32_t)atomic_get(&data->reports), (uint32_t)atomic_get(&data->doubles));
+    return 0;
+}
+
+static int cmd_encoder_reset(const struct shell *sh, size_t argc, char **argv) {
+    struct qdec_data *data = qdec_dev->data;
+
+    atomic_clear(&data->steps);
+    atomic_clear(&data->doubles);
+    atomic_clear(&data->reports);
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_encoder,
+                               SHELL_CMD(reset, NULL, "Clear the counts", cmd_encoder_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((arixa), encoder, &sub_encoder, "QDEC encoder steps and dropped double steps",
+                 cmd_encoder_show, 1, 0);
+
+#endif
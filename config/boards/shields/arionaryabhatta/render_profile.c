@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <lvgl.h>
+
+#include "render_profile.h"
+#include "display_flush.h"
+
+static const char *const slot_names[RENDER_PROFILE_SLOT_COUNT] = {
+    [RENDER_PROFILE_OUTPUT_STATUS] = "output_status",
+    [RENDER_PROFILE_MODIFIERS] = "modifiers",
+    [RENDER_PROFILE_BONGO_CAT] = "bongo_cat",
+    [RENDER_PROFILE_BATTERY_STATUS] = "battery_status",
+    [RENDER_PROFILE_LOCAL_BATTERY] = "local_battery",
+    [RENDER_PROFILE_POWER_STATUS] = "power_status",
+    [RENDER_PROFILE_LATENCY_STATUS] = "latency_status",
+    [RENDER_PROFILE_LAYER_STATUS] = "layer_status",
+    [RENDER_PROFILE_HID_INDICATORS] = "hid_indicators",
+    [RENDER_PROFILE_REFRESH] = "lvgl refresh",
+    [RENDER_PROFILE_FLUSH] = "flush",
+};
+
+static struct zmk_render_profile_stats profile[RENDER_PROFILE_SLOT_COUNT];
+static struct k_spinlock lock;
+
+static void (*lvgl_refr_cb)(lv_timer_t *timer);
+static void (*lvgl_flush_cb)(struct _lv_disp_drv_t *disp_drv, const lv_area_t *area,
+                             lv_color_t *color_p);
+
+static void hist_add(struct zmk_render_profile_hist *hist, uint32_t value) {
+    int bucket = MIN(value > 0 ? 31 - __builtin_clz(value) : 0, RENDER_PROFILE_BUCKETS - 1);
+
+    if (hist->buckets[bucket] < UINT16_MAX) {
+        hist->buckets[bucket]++;
+    }
+}
+
+void zmk_render_profile_record(enum zmk_render_profile_slot slot, uint32_t cycles, uint32_t area,
+                               uint32_t bytes, uint32_t page_mask) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    struct zmk_render_profile_stats *stats = &profile[slot];
+    int pages = MIN(POPCOUNT(page_mask), RENDER_PROFILE_MAX_PAGES);
+
+    stats->count++;
+    stats->max_cycles = MAX(stats->max_cycles, cycles);
+    stats->total_cycles += cycles;
+    stats->total_area += area;
+    stats->total_bytes += bytes;
+    hist_add(&stats->cycles, cycles);
+    hist_add(&stats->area, area);
+    hist_add(&stats->bytes, bytes);
+    stats->max_pages = MAX(stats->max_pages, pages);
+    if (stats->pages[pages] < UINT16_MAX) {
+        stats->pages[pages]++;
+    }
+
+    k_spin_unlock(&lock, key);
+}
+
+// Pixels waiting to be redrawn. LVGL only joins overlapping areas at refresh time, so this
+// over-counts overlaps between widgets but not within a single update.
+static uint32_t invalidated_area(lv_disp_t *disp) {
+    uint32_t area = 0;
+
+    if (disp == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < disp->inv_p; i++) {
+        if (!disp->inv_area_joined[i]) {
+            area += lv_area_get_size(&disp->inv_areas[i]);
+        }
+    }
+
+    return area;
+}
+
+static uint32_t area_pages(const lv_area_t *area) {
+    int first = CLAMP(area->y1 / 8, 0, RENDER_PROFILE_MAX_PAGES - 1);
+    int last = CLAMP(area->y2 / 8, 0, RENDER_PROFILE_MAX_PAGES - 1);
+
+    return GENMASK(last, first);
+}
+
+// Pages covered by the invalidation areas from index first on. Areas LVGL dropped because an
+// earlier one already covers them are not seen, their pages are redrawn either way.
+static uint32_t invalidated_pages(lv_disp_t *disp, int first) {
+    uint32_t pages = 0;
+
+    if (disp == NULL) {
+        return 0;
+    }
+
+    for (int i = first; i < disp->inv_p; i++) {
+        if (!disp->inv_area_joined[i]) {
+            pages |= area_pages(&disp->inv_areas[i]);
+        }
+    }
+
+    return pages;
+}
+
+struct zmk_render_profile_mark zmk_render_profile_begin() {
+    lv_disp_t *disp = lv_disp_get_default();
+
+    return (struct zmk_render_profile_mark){
+        .cycles = k_cycle_get_32(),
+        .area = invalidated_area(disp),
+        .inv_p = disp != NULL ? disp->inv_p : 0,
+    };
+}
+
+void zmk_render_profile_end(enum zmk_render_profile_slot slot,
+                            const struct zmk_render_profile_mark *mark) {
+    lv_disp_t *disp = lv_disp_get_default();
+    uint32_t cycles = k_cycle_get_32() - mark->cycles;
+    uint32_t area = invalidated_area(disp);
+    bool overflowed = disp != NULL && disp->inv_p < mark->inv_p;
+
+    // a full invalidation buffer collapses into one screen sized area
+    zmk_render_profile_record(slot, cycles,
+                              overflowed || area < mark->area ? area : area - mark->area, 0,
+                              invalidated_pages(disp, overflowed ? 0 : mark->inv_p));
+}
+
+static void profile_refr_cb(lv_timer_t *timer) {
+    lv_disp_t *disp = lv_disp_get_default();
+    uint32_t area = invalidated_area(disp);
+    uint32_t pages = invalidated_pages(disp, 0);
+    uint32_t start = k_cycle_get_32();
+
+    lvgl_refr_cb(timer);
+
+    if (area > 0) {
+        zmk_render_profile_record(RENDER_PROFILE_REFRESH, k_cycle_get_32() - start, area, 0,
+                                  pages);
+    }
+}
+
+static void profile_flush_cb(struct _lv_disp_drv_t *disp_drv, const lv_area_t *area,
+                             lv_color_t *color_p) {
+    uint32_t bytes = lv_area_get_width(area) * DIV_ROUND_UP(lv_area_get_height(area), 8);
+    uint32_t start = k_cycle_get_32();
+
+#if IS_ENABLED(CONFIG_ARIXA_DISPLAY_SHADOW_FLUSH)
+    struct zmk_display_flush_stats before, after;
+
+    zmk_display_flush_get_stats(&before);
+    lvgl_flush_cb(disp_drv, area, color_p);
+    zmk_display_flush_get_stats(&after);
+
+    // pages sent around the shadow flush leave bytes_sent untouched
+    if (after.bytes_sent != before.bytes_sent || after.bytes_skipped != before.bytes_skipped) {
+        bytes = after.bytes_sent - before.bytes_sent;
+    }
+#else
+    lvgl_flush_cb(disp_drv, area, color_p);
+#endif
+
+    zmk_render_profile_record(RENDER_PROFILE_FLUSH, k_cycle_get_32() - start,
+                              lv_area_get_size(area), bytes, area_pages(area));
+}
+
+const char *zmk_render_profile_slot_name(enum zmk_render_profile_slot slot) {
+    return slot_names[slot];
+}
+
+void zmk_render_profile_get(enum zmk_render_profile_slot slot,
+                            struct zmk_render_profile_stats *out) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    *out = profile[slot];
+    k_spin_unlock(&lock, key);
+}
+
+void zmk_render_profile_reset() {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    memset(profile, 0, sizeof(profile));
+    k_spin_unlock(&lock, key);
+}
+
+int zmk_render_profile_init() {
+    lv_disp_t *disp = lv_disp_get_default();
+
+    if (disp == NULL) {
+        return -ENODEV;
+    }
+
+    // wraps whatever flush_cb is installed, so this runs after the shadow flush init
+    if (lvgl_flush_cb == NULL) {
+        lvgl_flush_cb = disp->driver->flush_cb;
+        disp->driver->flush_cb = profile_flush_cb;
+    }
+
+    if (lvgl_refr_cb == NULL) {
+        lvgl_refr_cb = disp->refr_timer->timer_cb;
+        disp->refr_timer->timer_cb = profile_refr_cb;
+    }
+
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+
+static void print_hist(const struct shell *sh, const char *name,
+                       const struct zmk_render_profile_hist *hist) {
+    char line[RENDER_PROFILE_BUCKETS * 12];
+    int len = 0;
+
+    for (int i = 0; i < RENDER_PROFILE_BUCKETS; i++) {
+        if (hist->buckets[i] > 0 && len < (int)sizeof(line)) {
+            len += snprintk(line + len, sizeof(line) - len, " <%u:%u",
+                            i == RENDER_PROFILE_BUCKETS - 1 ? UINT32_MAX : (uint32_t)BIT(i + 1) - 1,
+                            hist->buckets[i]);
+        }
+    }
+
+    if (len > 0) {
+        shell_print(sh, "    %-6s%s", name, line);
+    }
+}
+
+static void print_pages(const struct shell *sh, const struct zmk_render_profile_stats *stats) {
+    char line[(RENDER_PROFILE_MAX_PAGES + 1) * 12];
+    int len = 0;
+
+    for (int i = 0; i <= RENDER_PROFILE_MAX_PAGES; i++) {
+        if (stats->pages[i] > 0 && len < (int)sizeof(line)) {
+            len += snprintk(line + len, sizeof(line) - len, " %d:%u", i, stats->pages[i]);
+        }
+    }
+
+    shell_print(sh, "    %-6s%s (max %u)", "pages", line, stats->max_pages);
+}
+
+static int cmd_profile_show(const struct shell *sh, size_t argc, char **argv) {
+    struct zmk_render_profile_stats stats;
+
+    for (int slot = 0; slot < RENDER_PROFILE_SLOT_COUNT; slot++) {
+        zmk_render_profile_get(slot, &stats);
+        if (stats.count == 0) {
+            continue;
+        }
+
+        shell_print(sh, "%s: %u calls, avg %u us, max %u us, %llu px, %llu B", slot_names[slot],
+                    stats.count, k_cyc_to_us_floor32(stats.total_cycles / stats.count),
+                    k_cyc_to_us_floor32(stats.max_cycles), stats.total_area, stats.total_bytes);
+        print_hist(sh, "cycles", &stats.cycles);
+        print_hist(sh, "px", &stats.area);
+        print_hist(sh, "bytes", &stats.bytes);
+        print_pages(sh, &stats);
+    }
+
+    return 0;
+}
+
+static int cmd_profile_reset(const struct shell *sh, size_t argc, char **argv) {
+    zmk_render_profile_reset();
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profile,
+                               SHELL_CMD(reset, NULL, "Clear the render profile", cmd_profile_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_SUBCMD_ADD((arixa), profile, &sub_profile,
+                 "Per widget update, LVGL refresh and flush histograms", cmd_profile_show, 1, 0);
+
+#endif
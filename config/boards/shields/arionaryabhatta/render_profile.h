@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+enum zmk_render_profile_slot {
+    RENDER_PROFILE_OUTPUT_STATUS,
+    RENDER_PROFILE_MODIFIERS,
+    RENDER_PROFILE_BONGO_CAT,
+    RENDER_PROFILE_BATTERY_STATUS,
+    RENDER_PROFILE_LOCAL_BATTERY,
+    RENDER_PROFILE_POWER_STATUS,
+    RENDER_PROFILE_LATENCY_STATUS,
+    RENDER_PROFILE_LAYER_STATUS,
+    RENDER_PROFILE_HID_INDICATORS,
+    RENDER_PROFILE_REFRESH,
+    RENDER_PROFILE_FLUSH,
+    RENDER_PROFILE_SLOT_COUNT
+};
+
+// log2 buckets, bucket n counts values in [2^n, 2^(n+1)) and bucket 0 also holds 0
+#define RENDER_PROFILE_BUCKETS 24
+
+struct zmk_render_profile_hist {
+    uint16_t buckets[RENDER_PROFILE_BUCKETS];
+};
+
+// SSD1306 pages are 8 rows, a 64 row panel has 8 of them
+#define RENDER_PROFILE_MAX_PAGES 8
+
+struct zmk_render_profile_stats {
+    uint32_t count;
+    uint32_t max_cycles;
+    uint64_t total_cycles;
+    uint64_t total_area;
+    uint64_t total_bytes;
+    struct zmk_render_profile_hist cycles;
+    struct zmk_render_profile_hist area;  // invalidated pixels
+    struct zmk_render_profile_hist bytes; // bytes flushed to the panel
+    uint8_t max_pages;
+    uint16_t pages[RENDER_PROFILE_MAX_PAGES + 1]; // updates by number of display pages touched
+};
+
+struct zmk_render_profile_mark {
+    uint32_t cycles;
+    uint32_t area;
+    uint16_t inv_p;
+};
+
+int zmk_render_profile_init();
+const char *zmk_render_profile_slot_name(enum zmk_render_profile_slot slot);
+void zmk_render_profile_get(enum zmk_render_profile_slot slot, struct zmk_render_profile_stats *out);
+void zmk_render_profile_reset();
+
+// For renderers that bypass the LVGL hooks, page_mask has bit n set when page n was touched.
+void zmk_render_profile_record(enum zmk_render_profile_slot slot, uint32_t cycles, uint32_t area,
+                               uint32_t bytes, uint32_t page_mask);
+
+struct zmk_render_profile_mark zmk_render_profile_begin();
+void zmk_render_profile_end(enum zmk_render_profile_slot slot,
+                            const struct zmk_render_profile_mark *mark);
+
+// Wrap a widget update callback body, both compile away without ARIXA_RENDER_PROFILE.
+#if IS_ENABLED(CONFIG_ARIXA_RENDER_PROFILE)
+#define RENDER_PROFILE_BEGIN(slot)                                                                 \
+    const struct zmk_render_profile_mark _render_profile_mark = zmk_render_profile_begin()
+#define RENDER_PROFILE_END(slot) zmk_render_profile_end(slot, &_render_profile_mark)
+#else
+#define RENDER_PROFILE_BEGIN(slot)
+#define RENDER_PROFILE_END(slot)
+#endif
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+#
+# SPDX-License-Identifier: MIT
+
+"""Encode the bongo cat frames as one keyframe plus XOR deltas.
+
+Reads the 1 bit PBM frames from assets/bongo_cat and writes a C file holding
+the keyframe pixels and, per frame, the runs of bytes that differ from the
+keyframe together with the pixel bounding box of those bytes.
+
+With --pages the frames are stored page-native for the SSD1306: rows of
+8 pixel tall pages, each byte one column with the top pixel in bit 0.
+"""
+
+import os
+import sys
+
+from img_pack import PALETTE_SIZE, read_pbm
+
+KEYFRAME = "bongo_cat_both1"
+
+# Changed runs closer than this are joined, every run costs a two byte header.
+RUN_MERGE_GAP = 2
+
+
+def read_frames(paths):
+    frames = {}
+    for path in sorted(paths):
+        w, h, data = read_pbm(path)
+        frames[os.path.splitext(os.path.basename(path))[0]] = {"w": w, "h": h, "data": data}
+    return frames
+
+
+def to_pages(data, w, h):
+    stride = (w + 7) // 8
+    pages = []
+    for page in range((h + 7) // 8):
+        for x in range(w):
+            byte = 0
+            for bit in range(min(8, h - page * 8)):
+                if data[(page * 8 + bit) * stride + x // 8] & (0x80 >> (x % 8)):
+                    byte |= 1 << bit
+            pages.append(byte)
+    return pages
+
+
+def delta_runs(data, keyframe):
+    changed = [i for i, (a, b) in enumerate(zip(data, keyframe)) if a != b]
+    runs = []
+    for i in changed:
+        if runs and i - runs[-1][1] - 1 <= RUN_MERGE_GAP:
+            runs[-1][1] = i
+        else:
+            runs.append([i, i])
+    return [(start, end - start + 1) for start, end in runs]
+
+
+def bounding_box(runs, w, h, pages):
+    if not runs:
+        return (0, 0, -1, -1)
+    offsets = [start + i for start, length in runs for i in range(length)]
+    if pages:
+        rows = [o // w for o in offsets]
+        cols = [o % w for o in offsets]
+        return (min(cols), min(rows) * 8, max(cols), min(max(rows) * 8 + 7, h - 1))
+
+    stride = (w + 7) // 8
+    rows = [o // stride for o in offsets]
+    cols = [o % stride for o in offsets]
+    return (min(cols) * 8, min(rows), min(max(cols) * 8 + 7, w - 1), max(rows))
+
+
+def c_bytes(values, indent="    "):
+    lines = []
+    for i in range(0, len(values), 12):
+        lines.append(indent + ", ".join("0x%02x" % v for v in values[i : i + 12]) + ",")
+    return "\n".join(lines)
+
+
+def main(output_path, frame_paths, pages):
+    frames = read_frames(frame_paths)
+
+    keyframe = frames[KEYFRAME]
+    w, h = keyframe["w"], keyframe["h"]
+    if pages:
+        for frame in frames.values():
+            frame["data"] = to_pages(frame["data"], frame["w"], frame["h"])
+    if len(keyframe["data"]) > 256:
+        sys.exit("frames too large for one byte delta offsets")
+
+    out = [
+        "/*",
+        " * Generated by bongo_cat_delta.py, do not edit.",
+        " */",
+        "",
+        '#include "bongo_cat_frames.h"',
+        "",
+        "BUILD_ASSERT(BONGO_CAT_WIDTH == %d && BONGO_CAT_HEIGHT == %d);" % (w, h),
+        "BUILD_ASSERT(BONGO_CAT_DATA_SIZE == %d, \"frame layout differs from the build config\");"
+        % len(keyframe["data"]),
+        "",
+        "const uint8_t bongo_cat_keyframe[BONGO_CAT_DATA_SIZE] = {",
+        c_bytes(keyframe["data"]),
+        "};",
+        "",
+    ]
+
+    entries = []
+    total = len(keyframe["data"])
+    for name, frame in frames.items():
+        if (frame["w"], frame["h"]) != (w, h):
+            sys.exit("%s: frame size differs from the keyframe" % name)
+
+        runs = delta_runs(frame["data"], keyframe["data"])
+        encoded = []
+        for start, length in runs:
+            encoded += [start, length]
+            encoded += [frame["data"][start + i] ^ keyframe["data"][start + i] for i in range(length)]
+        total += len(encoded)
+
+        enum = "BONGO_CAT_FRAME_" + name[len("bongo_cat_"):].upper()
+        x1, y1, x2, y2 = bounding_box(runs, w, h, pages)
+        if encoded:
+            out += ["static const uint8_t %s_delta[] = {" % name, c_bytes(encoded), "};", ""]
+            delta = "%s_delta, .delta_size = sizeof(%s_delta)" % (name, name)
+        else:
+            delta = "NULL, .delta_size = 0"
+        entries.append(
+            "    [%s] = {.delta = %s, .area = {%d, %d, %d, %d}},"
+            % (enum, delta, x1, y1, x2, y2)
+        )
+
+    out += [
+        "const struct bongo_cat_frame bongo_cat_frames[BONGO_CAT_FRAME_COUNT] = {",
+        *entries,
+        "};",
+        "",
+    ]
+
+    with open(output_path, "w") as f:
+        f.write("\n".join(out))
+
+    print(
+        "bongo cat: %d frames, %d bytes encoded (%d as full bitmaps)"
+        % (len(frames), total, len(frames) * (len(keyframe["data"]) + PALETTE_SIZE))
+    )
+
+
+if __name__ == "__main__":
+    args = sys.argv[1:]
+    pages = "--pages" in args
+    if pages:
+        args.remove("--pages")
+    if len(args) < 2:
+        sys.exit("usage: bongo_cat_delta.py [--pages] <output.c> <frame.pbm>...")
+    main(args[0], args[1:], pages)
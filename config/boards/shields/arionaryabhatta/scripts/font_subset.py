@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+#
+# SPDX-License-Identifier: MIT
+
+"""Subset an LVGL bitmap font to the characters the status screen can draw.
+
+The character set is digits and space, the characters of every string
+literal in the given widget sources (printf conversions are dropped, "%%"
+counts as "%"), and the layer names from the keymap. Glyphs are copied out of
+an LVGL font converter C file, such as lv_font_unscii_8.c from the LVGL module,
+into a new font with a sparse character map.
+"""
+
+import argparse
+import re
+import string
+import sys
+
+BASE_CHARS = string.digits + " "
+
+FORMAT_CONVERSION = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z)?[a-zA-Z]")
+
+
+def literal_chars(path):
+    with open(path) as f:
+        source = f.read()
+
+    source = re.sub(r"/\*.*?\*/|//[^\n]*", "", source, flags=re.S)
+    chars = set()
+    for line in source.splitlines():
+        # includes, log messages and assertion text never reach the screen
+        if re.match(r"\s*#|.*\b(LOG_\w+|BUILD_ASSERT|__ASSERT\w*)\s*\(", line):
+            continue
+        for literal in re.findall(r'"((?:[^"\\]|\\.)*)"', line):
+            text = FORMAT_CONVERSION.sub("", literal.replace("%%", "\0")).replace("\0", "%")
+            chars.update(bytes(text, "utf-8").decode("unicode_escape"))
+    return chars
+
+
+def keymap_chars(path):
+    with open(path) as f:
+        keymap = f.read()
+    names = re.findall(r'\b(?:display-name|label)\s*=\s*"([^"]*)"', keymap)
+    return set("".join(names))
+
+
+def parse_font(path):
+    with open(path) as f:
+        source = f.read()
+    source = re.sub(r"/\*.*?\*/", "", source, flags=re.S)
+
+    def block(name):
+        match = re.search(r"\b%s\[\]\s*=\s*\{(.*?)\};" % name, source, re.S)
+        if match is None:
+            sys.exit("%s: no %s table" % (path, name))
+        return match.group(1)
+
+    def fields(text):
+        return {k: v for k, v in re.findall(r"\.(\w+)\s*=\s*([-\w]+)", text)}
+
+    bitmap = [int(b, 16) for b in re.findall(r"0x[0-9a-fA-F]+", block("glyph_bitmap"))]
+    glyphs = [fields(g) for g in re.findall(r"\{([^{}]*bitmap_index[^{}]*)\}", block("glyph_dsc"))]
+    cmaps = [fields(c) for c in re.findall(r"\{([^{}]*range_start[^{}]*)\}", block("cmaps"))]
+
+    dsc = fields(re.search(r"lv_font_fmt_txt_dsc_t\s+\w+\s*=\s*\{(.*?)\};", source, re.S).group(1))
+    font = fields(re.search(r"lv_font_t\s+\w+\s*=\s*\{(.*?)\};", source, re.S).group(1))
+
+    codepoints = {}
+    for cmap in cmaps:
+        if cmap["type"] != "LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY":
+            sys.exit("%s: only FORMAT0_TINY character maps are supported" % path)
+        for i in range(int(cmap["range_length"])):
+            codepoints[int(cmap["range_start"]) + i] = int(cmap["glyph_id_start"]) + i
+
+    return {
+        "bitmap": bitmap,
+        "glyphs": glyphs,
+        "codepoints": codepoints,
+        "bpp": int(dsc["bpp"]),
+        "line_height": int(font["line_height"]),
+        "base_line": int(font["base_line"]),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--font", required=True, help="LVGL font converter C file")
+    parser.add_argument("--name", required=True, help="name of the generated lv_font_t")
+    parser.add_argument("--keymap")
+    parser.add_argument("-o", "--output", required=True)
+    parser.add_argument("sources", nargs="*")
+    args = parser.parse_args()
+
+    chars = set(BASE_CHARS)
+    for path in args.sources:
+        chars |= literal_chars(path)
+    if args.keymap:
+        chars |= keymap_chars(args.keymap)
+
+    font = parse_font(args.font)
+    missing = sorted(c for c in chars if ord(c) not in font["codepoints"])
+    if missing:
+        print("%s: no glyphs for %s" % (args.name, "".join(missing)))
+    codepoints = sorted(ord(c) for c in chars if ord(c) in font["codepoints"])
+
+    bitmap = []
+    bitmap_size = 0
+    glyph_dsc = ["    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},"]
+    for cp in codepoints:
+        glyph = font["glyphs"][font["codepoints"][cp]]
+        start = int(glyph["bitmap_index"])
+        size = (int(glyph["box_w"]) * int(glyph["box_h"]) * font["bpp"] + 7) // 8
+
+        bitmap.append("    /* U+%04X %s */" % (cp, repr(chr(cp))))
+        if size > 0:
+            bitmap.append("    " + ", ".join("0x%02x" % b for b in font["bitmap"][start : start + size]) + ",")
+        glyph_dsc.append(
+            "    {.bitmap_index = %d, .adv_w = %s, .box_w = %s, .box_h = %s, .ofs_x = %s, .ofs_y = %s},"
+            % (bitmap_size, glyph["adv_w"], glyph["box_w"], glyph["box_h"], glyph["ofs_x"],
+               glyph["ofs_y"])
+        )
+        bitmap_size += size
+
+    first = codepoints[0]
+    out = [
+        "/*",
+        " * Generated by font_subset.py, do not edit.",
+        " * Characters: %s" % "".join(chr(cp) for cp in codepoints).replace("*/", "* /"),
+        " */",
+        "",
+        "#include <lvgl.h>",
+        "",
+        "static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {",
+        *bitmap,
+        "};",
+        "",
+        "static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {",
+        *glyph_dsc,
+        "};",
+        "",
+        "static const uint16_t unicode_list[] = {",
+        "    " + ", ".join("0x%x" % (cp - first) for cp in codepoints) + ",",
+        "};",
+        "",
+        "static const lv_font_fmt_txt_cmap_t cmaps[] = {",
+        "    {",
+        "        .range_start = %d," % first,
+        "        .range_length = %d," % (codepoints[-1] - first + 1),
+        "        .glyph_id_start = 1,",
+        "        .unicode_list = unicode_list,",
+        "        .glyph_id_ofs_list = NULL,",
+        "        .list_length = %d," % len(codepoints),
+        "        .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY,",
+        "    },",
+        "};",
+        "",
+        "static lv_font_fmt_txt_glyph_cache_t cache;",
+        "",
+        "static const lv_font_fmt_txt_dsc_t font_dsc = {",
+        "    .glyph_bitmap = glyph_bitmap,",
+        "    .glyph_dsc = glyph_dsc,",
+        "    .cmaps = cmaps,",
+        "    .kern_dsc = NULL,",
+        "    .kern_scale = 0,",
+        "    .cmap_num = 1,",
+        "    .bpp = %d," % font["bpp"],
+        "    .kern_classes = 0,",
+        "    .bitmap_format = 0,",
+        "    .cache = &cache,",
+        "};",
+        "",
+        "const lv_font_t %s = {" % args.name,
+        "    .get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt,",
+        "    .get_glyph_bitmap = lv_font_get_bitmap_fmt_txt,",
+        "    .line_height = %d," % font["line_height"],
+        "    .base_line = %d," % font["base_line"],
+        "    .subpx = LV_FONT_SUBPX_NONE,",
+        "    .underline_position = 0,",
+        "    .underline_thickness = 0,",
+        "    .dsc = &font_dsc,",
+        "};",
+        "",
+    ]
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(out))
+
+    print("%s: %d of %d glyphs" % (args.name, len(codepoints), len(font["codepoints"])))
+
+
+if __name__ == "__main__":
+    main()
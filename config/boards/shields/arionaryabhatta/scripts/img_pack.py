@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 The ZMK Contributors
+#
+# SPDX-License-Identifier: MIT
+
+"""Pack 1 bit PBM bitmaps into LVGL image descriptors.
+
+Every image becomes an LV_IMG_CF_ALPHA_1BIT descriptor named after its file,
+so no per image palette is stored: set pixels are drawn in the image recolor
+(black unless a style says otherwise) and clear pixels are transparent.
+
+With --rle, images that get smaller are stored run length encoded in flash
+and unpacked into RAM at boot. A per asset flash size report is printed.
+"""
+
+import argparse
+import os
+import sys
+
+# bytes the LVGL converter spends on the two palette entries of an indexed 1 bit image
+PALETTE_SIZE = 8
+
+
+def read_pbm(path):
+    """Returns (width, height, rows packed MSB first with byte aligned rows)."""
+    with open(path, "rb") as f:
+        raw = f.read()
+
+    tokens = []
+    pos = 0
+    # header: magic, width, height, comments allowed between them
+    while len(tokens) < 3:
+        while raw[pos : pos + 1].isspace():
+            pos += 1
+        if raw[pos : pos + 1] == b"#":
+            pos = raw.index(b"\n", pos)
+            continue
+        start = pos
+        while not raw[pos : pos + 1].isspace():
+            pos += 1
+        tokens.append(raw[start:pos].decode())
+
+    magic, w, h = tokens[0], int(tokens[1]), int(tokens[2])
+    stride = (w + 7) // 8
+
+    if magic == "P4":
+        data = list(raw[pos + 1 : pos + 1 + stride * h])
+    elif magic == "P1":
+        bits = [c for c in raw[pos:].decode() if c in "01"]
+        data = []
+        for y in range(h):
+            row = bits[y * w : (y + 1) * w]
+            for i in range(stride):
+                byte = 0
+                for bit, c in enumerate(row[i * 8 : i * 8 + 8]):
+                    byte |= (c == "1") << (7 - bit)
+                data.append(byte)
+    else:
+        sys.exit("%s: not a 1 bit PBM (P1 or P4)" % path)
+
+    if len(data) != stride * h:
+        sys.exit("%s: truncated pixel data" % path)
+    return w, h, data
+
+
+def rle_encode(data):
+    """PackBits style: n < 128 copies n + 1 literals, n >= 128 repeats the next byte n - 125 times."""
+    out = []
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and data[i + run] == data[i] and run < 130:
+            run += 1
+        if run >= 3:
+            out += [run + 125, data[i]]
+            i += run
+            continue
+
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 2 < len(data) and data[i] == data[i + 1] == data[i + 2]:
+                break
+            i += 1
+        out += [i - start - 1] + data[start:i]
+    return out
+
+
+def c_bytes(values, indent="    "):
+    lines = []
+    for i in range(0, len(values), 12):
+        lines.append(indent + ", ".join("0x%02x" % v for v in values[i : i + 12]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", required=True)
+    parser.add_argument("--rle", action="store_true", help="run length encode where it helps")
+    parser.add_argument("images", nargs="+")
+    args = parser.parse_args()
+
+    out = [
+        "/*",
+        " * Generated by img_pack.py, do not edit.",
+        " */",
+        "",
+        "#include <lvgl.h>",
+        "#include <zephyr/init.h>",
+        "",
+    ]
+    unpack = []
+    report = []
+    total = 0
+    total_indexed = 0
+
+    for path in sorted(args.images):
+        name = os.path.splitext(os.path.basename(path))[0]
+        w, h, data = read_pbm(path)
+        packed = rle_encode(data) if args.rle else None
+
+        if packed is not None and len(packed) < len(data):
+            out += [
+                "static uint8_t %s_map[%d];" % (name, len(data)),
+                "static const uint8_t %s_rle[] = {" % name,
+                c_bytes(packed),
+                "};",
+            ]
+            unpack.append("    unpack(%s_map, %s_rle, sizeof(%s_rle));" % (name, name, name))
+            size = len(packed)
+        else:
+            out += ["static const uint8_t %s_map[] = {" % name, c_bytes(data), "};"]
+            size = len(data)
+
+        out += [
+            "",
+            "const lv_img_dsc_t %s = {" % name,
+            "    .header.cf = LV_IMG_CF_ALPHA_1BIT,",
+            "    .header.always_zero = 0,",
+            "    .header.reserved = 0,",
+            "    .header.w = %d," % w,
+            "    .header.h = %d," % h,
+            "    .data_size = sizeof(%s_map)," % name,
+            "    .data = %s_map," % name,
+            "};",
+            "",
+        ]
+
+        total += size
+        total_indexed += len(data) + PALETTE_SIZE
+        report.append(
+            "  %-20s %3dx%-3d %5d B%s"
+            % (name, w, h, size, " (rle, %d B unpacked)" % len(data) if size != len(data) else "")
+        )
+
+    if unpack:
+        out += [
+            "static void unpack(uint8_t *dst, const uint8_t *src, size_t size) {",
+            "    const uint8_t *end = src + size;",
+            "",
+            "    while (src < end) {",
+            "        uint8_t n = *src++;",
+            "",
+            "        if (n < 128) {",
+            "            memcpy(dst, src, n + 1);",
+            "            dst += n + 1;",
+            "            src += n + 1;",
+            "        } else {",
+            "            memset(dst, *src++, n - 125);",
+            "            dst += n - 125;",
+            "        }",
+            "    }",
+            "}",
+            "",
+            "static int img_pack_unpack(void) {",
+            *unpack,
+            "    return 0;",
+            "}",
+            "",
+            "SYS_INIT(img_pack_unpack, APPLICATION, 0);",
+            "",
+        ]
+        out.insert(out.index("#include <zephyr/init.h>") + 1, "#include <string.h>")
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(out))
+
+    print("%s: %d images" % (os.path.basename(args.output), len(report)))
+    print("\n".join(report))
+    print(
+        "  total %d B flash (%d B as indexed 1 bit images with palettes)" % (total, total_indexed)
+    )
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,11 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/shell/shell.h>
+
+// Root for the shield's diagnostics, modules add their own subcommands with SHELL_SUBCMD_ADD.
+SHELL_SUBCMD_SET_CREATE(sub_arixa, (arixa));
+SHELL_CMD_REGISTER(arixa, &sub_arixa, "arixaaryabhatta diagnostics", NULL);
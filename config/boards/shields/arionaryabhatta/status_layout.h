@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/devicetree.h>
+#include <zephyr/toolchain.h>
+
+#define LAYOUT_NODE DT_CHOSEN(arixa_status_layout)
+
+BUILD_ASSERT(DT_NODE_HAS_COMPAT(LAYOUT_NODE, arixa_status_layout),
+             "arixa,status-layout must be chosen for the status screen");
+
+#define WIDGET_RECT(name, i) DT_PROP_BY_IDX(DT_CHILD(LAYOUT_NODE, name), rect, i)
+#define WIDGET_Y(name)                                                                             \
+    (DT_PROP(DT_CHILD(LAYOUT_NODE, name), page_aligned) ? WIDGET_RECT(name, 1) & ~7               \
+                                                        : WIDGET_RECT(name, 1))
+
+// inclusive corners, as an lv_area_t initializer
+#define WIDGET_AREA(name)                                                                          \
+    {                                                                                              \
+        WIDGET_RECT(name, 0), WIDGET_Y(name), WIDGET_RECT(name, 0) + WIDGET_RECT(name, 2) - 1,     \
+            WIDGET_Y(name) + WIDGET_RECT(name, 3) - 1                                              \
+    }
+
+#define CHECK_WIDGET_RECT(node)                                                                    \
+    BUILD_ASSERT(DT_PROP_BY_IDX(node, rect, 0) + DT_PROP_BY_IDX(node, rect, 2) <=                  \
+                         DT_PROP(DT_CHOSEN(zephyr_display), width) &&                              \
+                     DT_PROP_BY_IDX(node, rect, 1) + DT_PROP_BY_IDX(node, rect, 3) <=              \
+                         DT_PROP(DT_CHOSEN(zephyr_display), height),                               \
+                 DT_NODE_FULL_NAME(node) " does not fit on the display");
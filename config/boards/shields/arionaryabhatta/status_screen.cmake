@@ -0,0 +1,114 @@
+# The status screen and its generated assets, also built by the native_sim harness in
+# tests/status_screen, so paths are taken from this file rather than the including directory.
+set(STATUS_SCREEN_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+zephyr_library()
+zephyr_library_sources(${ZEPHYR_BASE}/misc/empty_file.c)
+zephyr_library_include_directories(${ZEPHYR_LVGL_MODULE_DIR})
+zephyr_library_include_directories(${ZEPHYR_BASE}/lib/gui/lvgl/)
+zephyr_library_include_directories(${ZEPHYR_BASE}/drivers)
+zephyr_library_include_directories(${CMAKE_SOURCE_DIR}/include)
+zephyr_library_include_directories(${STATUS_SCREEN_DIR}/widgets)
+zephyr_library_sources(${STATUS_SCREEN_DIR}/custom_status_screen.c)
+zephyr_library_sources(${STATUS_SCREEN_DIR}/widgets/battery_glyphs.c)
+zephyr_library_sources(${STATUS_SCREEN_DIR}/oled_theme.c)
+zephyr_library_sources_ifdef(CONFIG_ARIXA_RENDER_PROFILE ${STATUS_SCREEN_DIR}/render_profile.c)
+if(CONFIG_ARIXA_STATUS_SCREEN_FRAMEBUFFER)
+    zephyr_library_sources(${STATUS_SCREEN_DIR}/compositor.c)
+    zephyr_library_sources(${STATUS_SCREEN_DIR}/widgets/compositor_widgets.c)
+else()
+    zephyr_library_sources(${STATUS_SCREEN_DIR}/anim_governor.c)
+    zephyr_library_sources_ifdef(CONFIG_ARIXA_DISPLAY_SHADOW_FLUSH
+                                 ${STATUS_SCREEN_DIR}/display_flush.c)
+    zephyr_library_sources_ifdef(CONFIG_ARIXA_DISPLAY_PAGE_NATIVE
+                                 ${STATUS_SCREEN_DIR}/display_pages.c)
+    zephyr_library_sources(${STATUS_SCREEN_DIR}/widgets/battery_status.c)
+    zephyr_library_sources_ifdef(CONFIG_ARIXA_BATTERY_GAUGE
+                                 ${STATUS_SCREEN_DIR}/widgets/local_battery.c)
+    zephyr_library_sources_ifdef(CONFIG_ARIXA_POWER_MODEL
+                                 ${STATUS_SCREEN_DIR}/widgets/power_status.c)
+    zephyr_library_sources_ifdef(CONFIG_ARIXA_KEY_LATENCY_PROBE
+                                 ${STATUS_SCREEN_DIR}/widgets/latency_status.c)
+    zephyr_library_sources_ifdef(CONFIG_ARIXA_LATENCY_PAGE ${STATUS_SCREEN_DIR}/latency_page.c)
+    zephyr_library_sources(${STATUS_SCREEN_DIR}/widgets/bongo_cat.c)
+    target_sources_ifdef(CONFIG_ZMK_HID_INDICATORS app PRIVATE
+                         ${STATUS_SCREEN_DIR}/widgets/hid_indicators.c)
+    zephyr_library_sources(${STATUS_SCREEN_DIR}/widgets/layer_status.c)
+    zephyr_library_sources(${STATUS_SCREEN_DIR}/widgets/modifiers.c)
+    zephyr_library_sources(${STATUS_SCREEN_DIR}/widgets/output_status.c)
+endif()
+file(GLOB BONGO_CAT_FRAMES CONFIGURE_DEPENDS ${STATUS_SCREEN_DIR}/assets/bongo_cat/*.pbm)
+if(CONFIG_ARIXA_BONGO_CAT_PAGES)
+    set(BONGO_CAT_DELTA_ARGS --pages)
+endif()
+add_custom_command(
+    OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/bongo_cat_frames.c
+    COMMAND ${PYTHON_EXECUTABLE} -B ${STATUS_SCREEN_DIR}/scripts/bongo_cat_delta.py
+            ${BONGO_CAT_DELTA_ARGS} ${CMAKE_CURRENT_BINARY_DIR}/bongo_cat_frames.c
+            ${BONGO_CAT_FRAMES}
+    DEPENDS ${STATUS_SCREEN_DIR}/scripts/bongo_cat_delta.py
+            ${STATUS_SCREEN_DIR}/scripts/img_pack.py
+            ${BONGO_CAT_FRAMES}
+)
+zephyr_library_sources(${CMAKE_CURRENT_BINARY_DIR}/bongo_cat_frames.c)
+file(GLOB ICON_IMAGES CONFIGURE_DEPENDS
+     ${STATUS_SCREEN_DIR}/assets/battery/*.pbm
+     ${STATUS_SCREEN_DIR}/assets/modifiers/*.pbm
+     ${STATUS_SCREEN_DIR}/assets/output_status/*.pbm)
+if(CONFIG_ARIXA_ASSETS_RLE)
+    set(IMG_PACK_ARGS --rle)
+endif()
+add_custom_command(
+    OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/icons.c
+    COMMAND ${PYTHON_EXECUTABLE} -B ${STATUS_SCREEN_DIR}/scripts/img_pack.py
+            ${IMG_PACK_ARGS} -o ${CMAKE_CURRENT_BINARY_DIR}/icons.c ${ICON_IMAGES}
+    DEPENDS ${STATUS_SCREEN_DIR}/scripts/img_pack.py ${ICON_IMAGES}
+)
+zephyr_library_sources(${CMAKE_CURRENT_BINARY_DIR}/icons.c)
+
+# unscii 8 cut down to the characters the label widgets can show
+set(FONT_SOURCES
+    ${STATUS_SCREEN_DIR}/widgets/battery_status.c
+    ${STATUS_SCREEN_DIR}/widgets/hid_indicators.c
+    ${STATUS_SCREEN_DIR}/widgets/layer_status.c
+    ${STATUS_SCREEN_DIR}/widgets/local_battery.h
+    ${STATUS_SCREEN_DIR}/widgets/power_status.h
+    ${STATUS_SCREEN_DIR}/widgets/latency_status.h
+    ${STATUS_SCREEN_DIR}/latency_page.c
+    ${STATUS_SCREEN_DIR}/widgets/compositor_widgets.c)
+if(DEFINED KEYMAP_FILE)
+    set(FONT_KEYMAP ${KEYMAP_FILE})
+else()
+    set(FONT_KEYMAP ${STATUS_SCREEN_DIR}/arixaaryabhatta.keymap)
+endif()
+add_custom_command(
+    OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/arixa_font_8.c
+    COMMAND ${PYTHON_EXECUTABLE} -B ${STATUS_SCREEN_DIR}/scripts/font_subset.py
+            --font ${ZEPHYR_LVGL_MODULE_DIR}/src/font/lv_font_unscii_8.c
+            --name arixa_font_8 --keymap ${FONT_KEYMAP}
+            -o ${CMAKE_CURRENT_BINARY_DIR}/arixa_font_8.c ${FONT_SOURCES}
+    DEPENDS ${STATUS_SCREEN_DIR}/scripts/font_subset.py ${FONT_KEYMAP} ${FONT_SOURCES}
+)
+zephyr_library_sources(${CMAKE_CURRENT_BINARY_DIR}/arixa_font_8.c)
+
+# every large LVGL font costs tens of KB, refuse to link one nothing draws with
+file(GLOB_RECURSE SCREEN_SOURCES ${STATUS_SCREEN_DIR}/*.c)
+foreach(font MONTSERRAT_20 MONTSERRAT_22 MONTSERRAT_24 MONTSERRAT_26 MONTSERRAT_28
+             MONTSERRAT_30 MONTSERRAT_32 MONTSERRAT_34 MONTSERRAT_36 MONTSERRAT_38
+             MONTSERRAT_40 MONTSERRAT_42 MONTSERRAT_44 MONTSERRAT_46 MONTSERRAT_48
+             UNSCII_16)
+    if(NOT CONFIG_LV_FONT_${font} OR CONFIG_LV_FONT_DEFAULT_${font})
+        continue()
+    endif()
+    string(TOLOWER "lv_font_${font}" symbol)
+    set(referenced FALSE)
+    foreach(source ${SCREEN_SOURCES})
+        file(STRINGS ${source} uses REGEX "${symbol}([^0-9]|$)")
+        if(uses)
+            set(referenced TRUE)
+        endif()
+    endforeach()
+    if(NOT referenced)
+        message(FATAL_ERROR "CONFIG_LV_FONT_${font} is enabled but no status screen source uses ${symbol}")
+    endif()
+endforeach()
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "battery_status.h"
+
+LV_IMG_DECLARE(battery_level_0);
+LV_IMG_DECLARE(battery_level_1);
+LV_IMG_DECLARE(battery_level_2);
+LV_IMG_DECLARE(battery_level_3);
+LV_IMG_DECLARE(battery_level_4);
+LV_IMG_DECLARE(battery_level_5);
+
+const lv_img_dsc_t *const battery_glyphs[BATTERY_LEVEL_GLYPHS] = {
+    &battery_level_0, &battery_level_1, &battery_level_2,
+    &battery_level_3, &battery_level_4, &battery_level_5,
+};
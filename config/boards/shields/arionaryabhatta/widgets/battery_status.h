@@ -8,10 +8,28 @@
 
 #include <lvgl.h>
 #include <zephyr/kernel.h>
+#include <zmk/ble.h>
+
+#include "widget_state.h"
+
+// battery_level_0 (empty) to battery_level_5 (full) in assets/battery, one per fill bucket
+#define BATTERY_LEVEL_GLYPHS 6
+
+extern const lv_img_dsc_t *const battery_glyphs[BATTERY_LEVEL_GLYPHS];
+
+static inline int battery_level_glyph(uint8_t level) {
+    return level > 90 ? 5 : level > 70 ? 4 : level > 50 ? 3 : level > 30 ? 2 : level > 10 ? 1 : 0;
+}
+
+struct peripheral_battery_state {
+    uint8_t source;
+    uint8_t level;
+};
 
 struct zmk_widget_peripheral_battery_status {
     sys_snode_t node;
     lv_obj_t *obj;
+    WIDGET_STATE(struct peripheral_battery_state) state[ZMK_SPLIT_BLE_PERIPHERAL_COUNT];
 };
 
 int zmk_widget_peripheral_battery_status_init(struct zmk_widget_peripheral_battery_status *widget, lv_obj_t *parent);
@@ -12,63 +12,193 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #include <zmk/display.h>
 #include <zmk/event_manager.h>
+#include <zmk/events/position_state_changed.h>
 #include <zmk/events/wpm_state_changed.h>
 #include <zmk/wpm.h>
 
 #include "bongo_cat.h"
-
-#define SRC(array) (const void **)array, sizeof(array) / sizeof(lv_img_dsc_t *)
+#include "bongo_cat_frames.h"
+#include "../anim_governor.h"
+#include "../render_profile.h"
+#include "../display_pages.h"
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
-LV_IMG_DECLARE(bongo_cat_none);
-LV_IMG_DECLARE(bongo_cat_left1);
-LV_IMG_DECLARE(bongo_cat_left2);
-LV_IMG_DECLARE(bongo_cat_right1);
-LV_IMG_DECLARE(bongo_cat_right2);
-LV_IMG_DECLARE(bongo_cat_both1);
-LV_IMG_DECLARE(bongo_cat_both1_open);
-LV_IMG_DECLARE(bongo_cat_both2);
+// the frame currently shown, patched in place from the keyframe by the frame deltas
+static uint8_t frame_map[BONGO_CAT_DATA_SIZE];
+
+#if !IS_ENABLED(CONFIG_ARIXA_DISPLAY_PAGE_NATIVE)
+static const lv_img_dsc_t frame_dsc = {
+    .header.cf = LV_IMG_CF_ALPHA_1BIT,
+    .header.always_zero = 0,
+    .header.reserved = 0,
+    .header.w = BONGO_CAT_WIDTH,
+    .header.h = BONGO_CAT_HEIGHT,
+    .data_size = sizeof(frame_map),
+    .data = frame_map,
+};
+#endif
+
+static enum bongo_cat_frame_id current_frame = BONGO_CAT_KEYFRAME;
+
+static void show_frame(enum bongo_cat_frame_id id) {
+    const struct bongo_cat_frame *from = &bongo_cat_frames[current_frame];
+    const struct bongo_cat_frame *to = &bongo_cat_frames[id];
+    lv_area_t area;
+
+    if (id == current_frame) {
+        return;
+    }
+
+    // undo the current delta to get back to the keyframe, then apply the new one
+    bongo_cat_apply_delta(frame_map, from);
+    bongo_cat_apply_delta(frame_map, to);
+    current_frame = id;
+
+    if (from->delta_size == 0) {
+        area = to->area;
+    } else if (to->delta_size == 0) {
+        area = from->area;
+    } else {
+        _lv_area_join(&area, &from->area, &to->area);
+    }
+
+    struct zmk_widget_bongo_cat *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) {
+        lv_area_t coords;
+        lv_area_t changed = area;
+
+        lv_obj_get_coords(widget->obj, &coords);
+        lv_area_move(&changed, coords.x1, coords.y1);
+        lv_obj_invalidate_area(widget->obj, &changed);
+    }
+}
+
+#if IS_ENABLED(CONFIG_ARIXA_BONGO_CAT_KEYSTROKE)
+
+static struct bongo_cat_key_state key_state;
+static uint32_t rendered_presses;
+static bool right_paw_next;
+
+static void rest_work_cb(struct k_work *work) {
+    show_frame(BONGO_CAT_KEYFRAME);
+}
+
+static K_WORK_DELAYABLE_DEFINE(rest_work, rest_work_cb);
+
+static struct bongo_cat_key_state bongo_cat_key_get_state(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+
+    if (ev != NULL) {
+        if (ev->state) {
+            key_state.presses++;
+            key_state.held++;
+        } else if (key_state.held > 0) {
+            key_state.held--;
+        }
+    }
+
+    return key_state;
+}
+
+static void bongo_cat_key_update_cb(struct bongo_cat_key_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_BONGO_CAT);
+
+    if (state.presses != rendered_presses) {
+        rendered_presses = state.presses;
+        show_frame(right_paw_next ? BONGO_CAT_FRAME_RIGHT1 : BONGO_CAT_FRAME_LEFT1);
+        right_paw_next = !right_paw_next;
+    } else if (state.held == 0 && current_frame != BONGO_CAT_KEYFRAME) {
+        show_frame(BONGO_CAT_FRAME_NONE);
+    }
+
+    if (state.held > 0) {
+        k_work_cancel_delayable(&rest_work);
+    } else {
+        k_work_reschedule_for_queue(zmk_display_work_q(), &rest_work,
+                                    K_MSEC(CONFIG_ARIXA_BONGO_CAT_REST_DELAY_MS));
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_BONGO_CAT);
+}
+
+static void bongo_cat_pause() {
+    k_work_cancel_delayable(&rest_work);
+    show_frame(BONGO_CAT_KEYFRAME);
+}
+
+static void bongo_cat_resume() {}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_bongo_cat, struct bongo_cat_key_state,
+                            bongo_cat_key_update_cb, bongo_cat_key_get_state)
+
+ZMK_SUBSCRIPTION(widget_bongo_cat, zmk_position_state_changed);
+
+#else
+
+#define SRC(array) array, ARRAY_SIZE(array)
 
 #define ANIMATION_SPEED_IDLE 10000
-const lv_img_dsc_t *idle_imgs[] = {
-    &bongo_cat_both1_open,
-    &bongo_cat_both1_open,
-    &bongo_cat_both1_open,
-    &bongo_cat_both1,
+static const uint8_t idle_frames[] = {
+    BONGO_CAT_FRAME_BOTH1_OPEN,
+    BONGO_CAT_FRAME_BOTH1_OPEN,
+    BONGO_CAT_FRAME_BOTH1_OPEN,
+    BONGO_CAT_FRAME_BOTH1,
 };
 
 #define ANIMATION_SPEED_SLOW 2000
-const lv_img_dsc_t *slow_imgs[] = {
-    &bongo_cat_left1,
-    &bongo_cat_both1,
-    &bongo_cat_both1,
-    &bongo_cat_right1,
-    &bongo_cat_both1,
-    &bongo_cat_both1,
-    &bongo_cat_left1,
-    &bongo_cat_both1,
-    &bongo_cat_both1,
+static const uint8_t slow_frames[] = {
+    BONGO_CAT_FRAME_LEFT1,
+    BONGO_CAT_FRAME_BOTH1,
+    BONGO_CAT_FRAME_BOTH1,
+    BONGO_CAT_FRAME_RIGHT1,
+    BONGO_CAT_FRAME_BOTH1,
+    BONGO_CAT_FRAME_BOTH1,
+    BONGO_CAT_FRAME_LEFT1,
+    BONGO_CAT_FRAME_BOTH1,
+    BONGO_CAT_FRAME_BOTH1,
 };
 
 #define ANIMATION_SPEED_MID 500
-const lv_img_dsc_t *mid_imgs[] = {
-    &bongo_cat_left2,
-    &bongo_cat_left1,
-    &bongo_cat_none,
-    &bongo_cat_right2,
-    &bongo_cat_right1,
-    &bongo_cat_none,
+static const uint8_t mid_frames[] = {
+    BONGO_CAT_FRAME_LEFT2,
+    BONGO_CAT_FRAME_LEFT1,
+    BONGO_CAT_FRAME_NONE,
+    BONGO_CAT_FRAME_RIGHT2,
+    BONGO_CAT_FRAME_RIGHT1,
+    BONGO_CAT_FRAME_NONE,
 };
 
 #define ANIMATION_SPEED_FAST 200
-const lv_img_dsc_t *fast_imgs[] = {
-    &bongo_cat_both2,
-    &bongo_cat_both1,
-    &bongo_cat_none,
-    &bongo_cat_none,
+static const uint8_t fast_frames[] = {
+    BONGO_CAT_FRAME_BOTH2,
+    BONGO_CAT_FRAME_BOTH1,
+    BONGO_CAT_FRAME_NONE,
+    BONGO_CAT_FRAME_NONE,
 };
 
+static const uint8_t *anim_frames;
+static size_t anim_frame_count;
+
+static void anim_frame_cb(void *var, int32_t v) {
+    show_frame(anim_frames[v % anim_frame_count]);
+}
+
+static void play_frames(const uint8_t *frames, size_t count, uint32_t duration) {
+    lv_anim_t a;
+
+    anim_frames = frames;
+    anim_frame_count = count;
+
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, frame_map);
+    lv_anim_set_time(&a, duration); // will be replaced with lv_anim_set_duration
+    lv_anim_set_exec_cb(&a, anim_frame_cb);
+    lv_anim_set_values(&a, 0, count);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_start(&a);
+}
+
 struct bongo_cat_wpm_status_state {
     uint8_t wpm;
 };
@@ -81,37 +211,25 @@ enum anim_state {
     anim_state_fast
 } current_anim_state;
 
-static void set_animation(lv_obj_t *animing, struct bongo_cat_wpm_status_state state) {
+static void set_animation(struct bongo_cat_wpm_status_state state) {
     if (state.wpm < 5) {
         if (current_anim_state != anim_state_idle) {
-            lv_animimg_set_src(animing, SRC(idle_imgs));
-            lv_animimg_set_duration(animing, ANIMATION_SPEED_IDLE);
-            lv_animimg_set_repeat_count(animing, LV_ANIM_REPEAT_INFINITE);
-            lv_animimg_start(animing);
+            play_frames(SRC(idle_frames), ANIMATION_SPEED_IDLE);
             current_anim_state = anim_state_idle;
         }
     } else if (state.wpm < 30) {
         if (current_anim_state != anim_state_slow) {
-            lv_animimg_set_src(animing, SRC(slow_imgs));
-            lv_animimg_set_duration(animing, ANIMATION_SPEED_SLOW);
-            lv_animimg_set_repeat_count(animing, LV_ANIM_REPEAT_INFINITE);
-            lv_animimg_start(animing);
+            play_frames(SRC(slow_frames), ANIMATION_SPEED_SLOW);
             current_anim_state = anim_state_slow;
         }
     } else if (state.wpm < 70) {
         if (current_anim_state != anim_state_mid) {
-            lv_animimg_set_src(animing, SRC(mid_imgs));
-            lv_animimg_set_duration(animing, ANIMATION_SPEED_MID);
-            lv_animimg_set_repeat_count(animing, LV_ANIM_REPEAT_INFINITE);
-            lv_animimg_start(animing);
+            play_frames(SRC(mid_frames), ANIMATION_SPEED_MID);
             current_anim_state = anim_state_mid;
         }
     } else {
         if (current_anim_state != anim_state_fast) {
-            lv_animimg_set_src(animing, SRC(fast_imgs));
-            lv_animimg_set_duration(animing, ANIMATION_SPEED_FAST);
-            lv_animimg_set_repeat_count(animing, LV_ANIM_REPEAT_INFINITE);
-            lv_animimg_start(animing);
+            play_frames(SRC(fast_frames), ANIMATION_SPEED_FAST);
             current_anim_state = anim_state_fast;
         }
     }
@@ -119,12 +237,32 @@ static void set_animation(lv_obj_t *animing, struct bongo_cat_wpm_status_state s
 
 struct bongo_cat_wpm_status_state bongo_cat_wpm_status_get_state(const zmk_event_t *eh) {
     struct zmk_wpm_state_changed *ev = as_zmk_wpm_state_changed(eh);
-    return (struct bongo_cat_wpm_status_state) { .wpm = ev->state };
+    return (struct bongo_cat_wpm_status_state) {
+        .wpm = (ev != NULL) ? ev->state : zmk_wpm_get_state()
+    };
 };
 
+static struct bongo_cat_wpm_status_state last_wpm_state;
+
 void bongo_cat_wpm_status_update_cb(struct bongo_cat_wpm_status_state state) {
-    struct zmk_widget_bongo_cat *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_animation(widget->obj, state); }
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_BONGO_CAT);
+
+    last_wpm_state = state;
+    if (!zmk_anim_governor_is_paused()) {
+        set_animation(state);
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_BONGO_CAT);
+}
+
+static void bongo_cat_pause() {
+    lv_anim_del(frame_map, anim_frame_cb);
+    show_frame(BONGO_CAT_KEYFRAME);
+    current_anim_state = anim_state_none;
+}
+
+static void bongo_cat_resume() {
+    set_animation(last_wpm_state);
 }
 
 ZMK_DISPLAY_WIDGET_LISTENER(widget_bongo_cat, struct bongo_cat_wpm_status_state,
@@ -132,8 +270,39 @@ ZMK_DISPLAY_WIDGET_LISTENER(widget_bongo_cat, struct bongo_cat_wpm_status_state,
 
 ZMK_SUBSCRIPTION(widget_bongo_cat, zmk_wpm_state_changed);
 
+#endif
+
+#if IS_ENABLED(CONFIG_ARIXA_DISPLAY_PAGE_NATIVE)
+// the frame is already in the panel's byte layout, so it is copied in a page at a time
+static void draw_pages_cb(lv_event_t *e) {
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_area_t coords;
+
+    lv_obj_get_coords(obj, &coords);
+    zmk_display_pages_draw(lv_event_get_draw_ctx(e), &coords, frame_map, BONGO_CAT_STRIDE);
+}
+#endif
+
+static struct zmk_anim_governor_client governor_client = {
+    .pause = bongo_cat_pause,
+    .resume = bongo_cat_resume,
+};
+
 int zmk_widget_bongo_cat_init(struct zmk_widget_bongo_cat *widget, lv_obj_t *parent) {
-    widget->obj = lv_animimg_create(parent);
+    if (sys_slist_is_empty(&widgets)) {
+        memcpy(frame_map, bongo_cat_keyframe, BONGO_CAT_DATA_SIZE);
+        zmk_anim_governor_register(&governor_client);
+    }
+
+#if IS_ENABLED(CONFIG_ARIXA_DISPLAY_PAGE_NATIVE)
+    widget->obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(widget->obj);
+    lv_obj_set_size(widget->obj, BONGO_CAT_WIDTH, BONGO_CAT_HEIGHT);
+    lv_obj_add_event_cb(widget->obj, draw_pages_cb, LV_EVENT_DRAW_MAIN, NULL);
+#else
+    widget->obj = lv_img_create(parent);
+    lv_img_set_src(widget->obj, &frame_dsc);
+#endif
     lv_obj_center(widget->obj);
 
     sys_slist_append(&widgets, &widget->node);
@@ -10,6 +10,13 @@
 #include <zephyr/kernel.h>
 #include <dt-bindings/zmk/modifiers.h>
 
+// press edges are counted rather than rendered directly, so a tap whose press and release are
+// coalesced into one update still shows a paw
+struct bongo_cat_key_state {
+    uint32_t presses;
+    uint8_t held;
+};
+
 struct zmk_widget_bongo_cat {
     sys_snode_t node;
     lv_obj_t *obj;
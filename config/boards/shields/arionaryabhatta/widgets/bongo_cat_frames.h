@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+
+#define BONGO_CAT_WIDTH 50
+#define BONGO_CAT_HEIGHT 26
+#if IS_ENABLED(CONFIG_ARIXA_BONGO_CAT_PAGES)
+// SSD1306 pages: rows of 8 pixel tall column bytes, top pixel in bit 0
+#define BONGO_CAT_STRIDE BONGO_CAT_WIDTH
+#define BONGO_CAT_DATA_SIZE (BONGO_CAT_STRIDE * ((BONGO_CAT_HEIGHT + 7) / 8))
+#else
+#define BONGO_CAT_STRIDE ((BONGO_CAT_WIDTH + 7) / 8)
+#define BONGO_CAT_DATA_SIZE (BONGO_CAT_STRIDE * BONGO_CAT_HEIGHT)
+#endif
+
+enum bongo_cat_frame_id {
+    BONGO_CAT_FRAME_NONE,
+    BONGO_CAT_FRAME_LEFT1,
+    BONGO_CAT_FRAME_LEFT2,
+    BONGO_CAT_FRAME_RIGHT1,
+    BONGO_CAT_FRAME_RIGHT2,
+    BONGO_CAT_FRAME_BOTH1,
+    BONGO_CAT_FRAME_BOTH1_OPEN,
+    BONGO_CAT_FRAME_BOTH2,
+    BONGO_CAT_FRAME_COUNT
+};
+
+// frame stored whole, matches KEYFRAME in scripts/bongo_cat_delta.py
+#define BONGO_CAT_KEYFRAME BONGO_CAT_FRAME_BOTH1
+
+// XOR delta against bongo_cat_keyframe, encoded as runs of
+// { offset, length, length bytes of xor data }
+struct bongo_cat_frame {
+    const uint8_t *delta;
+    uint16_t delta_size;
+    lv_area_t area; // pixels touched by the delta, relative to the image
+};
+
+extern const uint8_t bongo_cat_keyframe[BONGO_CAT_DATA_SIZE];
+extern const struct bongo_cat_frame bongo_cat_frames[BONGO_CAT_FRAME_COUNT];
+
+// patches pixels from the keyframe to the frame, or back again since the delta is an XOR
+static inline void bongo_cat_apply_delta(uint8_t *pixels, const struct bongo_cat_frame *frame) {
+    const uint8_t *delta = frame->delta;
+    const uint8_t *end = delta + frame->delta_size;
+
+    while (delta < end) {
+        uint8_t offset = delta[0];
+        uint8_t len = delta[1];
+
+        delta += 2;
+        for (int i = 0; i < len; i++) {
+            pixels[offset + i] ^= delta[i];
+        }
+        delta += len;
+    }
+}
@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#include <zmk/events/endpoint_changed.h>
+#include <zmk/events/usb_conn_state_changed.h>
+#include <zmk/events/battery_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/position_state_changed.h>
+#include <zmk/usb.h>
+#include <zmk/ble.h>
+#include <zmk/endpoints.h>
+#include <zmk/hid.h>
+#include <zmk/keymap.h>
+#include <dt-bindings/zmk/modifiers.h>
+
+#if IS_ENABLED(CONFIG_ZMK_HID_INDICATORS)
+#include <zmk/events/hid_indicators_changed.h>
+#endif
+
+#include "compositor_widgets.h"
+#include "output_status.h"
+#include "modifiers.h"
+#include "battery_status.h"
+#include "local_battery.h"
+#include "power_status.h"
+#include "latency_status.h"
+#include "layer_status.h"
+#include "hid_indicators.h"
+#include "bongo_cat.h"
+#include "bongo_cat_frames.h"
+#include "../compositor.h"
+#include "../status_layout.h"
+#include "../render_profile.h"
+#include "../events/explicit_mods_changed.h"
+#include "../events/battery_gauge_changed.h"
+#include "../events/power_estimate_changed.h"
+#include "../events/key_latency_changed.h"
+
+// Same states, events and placement as the LVGL widgets, drawn in their final position without
+// the sliding animations. Each widget redraws its whole box, the compositor only sends the
+// bytes that changed.
+
+// output status
+
+LV_IMG_DECLARE(sym_usb);
+LV_IMG_DECLARE(sym_bt);
+LV_IMG_DECLARE(sym_ok);
+LV_IMG_DECLARE(sym_nok);
+LV_IMG_DECLARE(sym_open);
+LV_IMG_DECLARE(sym_1);
+LV_IMG_DECLARE(sym_2);
+LV_IMG_DECLARE(sym_3);
+LV_IMG_DECLARE(sym_4);
+LV_IMG_DECLARE(sym_5);
+
+static const lv_img_dsc_t *const profile_symbols[] = {&sym_1, &sym_2, &sym_3, &sym_4, &sym_5};
+
+static const lv_area_t output_status_area = WIDGET_AREA(output_status);
+static WIDGET_STATE(struct output_status_state) output_status_cache;
+
+static void draw_output_status(struct output_status_state state) {
+    const lv_area_t *area = &output_status_area;
+    lv_coord_t x = area->x1;
+    lv_coord_t y = area->y1;
+    const lv_img_dsc_t *profile = &sym_nok;
+    const lv_img_dsc_t *status = &sym_open;
+
+    if (state.active_profile_index < ARRAY_SIZE(profile_symbols)) {
+        profile = profile_symbols[state.active_profile_index];
+    }
+    if (state.active_profile_bonded) {
+        status = state.active_profile_connected ? &sym_ok : &sym_nok;
+    }
+
+    zmk_compositor_fill(area, false);
+    zmk_compositor_draw_img(area, x + 1, y + 4, &sym_usb);
+    zmk_compositor_draw_img(area, x + 3, y + 11, state.usb_is_hid_ready ? &sym_ok : &sym_nok);
+    zmk_compositor_draw_img(area, x + 16, y + 4, &sym_bt);
+    zmk_compositor_draw_img(area, x + 27, y + 11, profile);
+    zmk_compositor_draw_img(area, x + 27, y + 5, status);
+
+    // the selection line under the active transport
+    if (state.selected_endpoint.transport == ZMK_TRANSPORT_USB) {
+        zmk_compositor_fill(&(lv_area_t){x, y + 1, x + 11, y + 2}, true);
+    } else {
+        zmk_compositor_fill(&(lv_area_t){x + 14, y + 1, x + 33, y + 2}, true);
+    }
+}
+
+static void output_status_update_cb(struct output_status_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_OUTPUT_STATUS);
+
+    if (WIDGET_STATE_CHANGED(&output_status_cache, state, selected_endpoint.transport) ||
+        WIDGET_STATE_CHANGED(&output_status_cache, state, active_profile_index) ||
+        WIDGET_STATE_CHANGED(&output_status_cache, state, active_profile_connected) ||
+        WIDGET_STATE_CHANGED(&output_status_cache, state, active_profile_bonded) ||
+        WIDGET_STATE_CHANGED(&output_status_cache, state, usb_is_hid_ready)) {
+        WIDGET_STATE_SAVE(&output_status_cache, state);
+        draw_output_status(state);
+        zmk_compositor_commit();
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_OUTPUT_STATUS);
+}
+
+static struct output_status_state output_status_get_state(const zmk_event_t *eh) {
+    return (struct output_status_state){
+        .selected_endpoint = zmk_endpoints_selected(),
+        .active_profile_index = zmk_ble_active_profile_index(),
+        .active_profile_connected = zmk_ble_active_profile_is_connected(),
+        .active_profile_bonded = !zmk_ble_active_profile_is_open(),
+        .usb_is_hid_ready = zmk_usb_is_hid_ready(),
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(compositor_output_status, struct output_status_state,
+                            output_status_update_cb, output_status_get_state)
+ZMK_SUBSCRIPTION(compositor_output_status, zmk_endpoint_changed);
+ZMK_SUBSCRIPTION(compositor_output_status, zmk_ble_active_profile_changed);
+ZMK_SUBSCRIPTION(compositor_output_status, zmk_usb_conn_state_changed);
+
+// modifiers
+
+LV_IMG_DECLARE(cmd_icon);
+LV_IMG_DECLARE(opt_icon);
+LV_IMG_DECLARE(control_icon);
+LV_IMG_DECLARE(shift_icon);
+
+// same order as the LVGL widget
+static const struct {
+    uint8_t modifiers;
+    const lv_img_dsc_t *icon;
+} modifier_symbols[] = {
+    {MOD_LGUI | MOD_RGUI, &cmd_icon},
+    {MOD_LALT | MOD_RALT, &opt_icon},
+    {MOD_LCTL | MOD_RCTL, &control_icon},
+    {MOD_LSFT | MOD_RSFT, &shift_icon},
+};
+
+static const lv_area_t modifiers_area = WIDGET_AREA(modifiers);
+static WIDGET_STATE(struct modifiers_state) modifiers_cache;
+
+static void draw_modifiers(struct modifiers_state state) {
+    const lv_area_t *area = &modifiers_area;
+
+    zmk_compositor_fill(area, false);
+
+    for (int i = 0; i < ARRAY_SIZE(modifier_symbols); i++) {
+        bool active = (state.modifiers & modifier_symbols[i].modifiers) != 0;
+        lv_coord_t x = area->x1 + 1 + (SIZE_SYMBOLS + 1) * i;
+        lv_area_t line = {x, area->y1 + SIZE_SYMBOLS + 2, x + SIZE_SYMBOLS,
+                          area->y1 + SIZE_SYMBOLS + 3};
+
+        // active symbols sit a pixel higher with their selection line showing below
+        zmk_compositor_draw_img(area, x, area->y1 + (active ? 0 : 1), modifier_symbols[i].icon);
+        if (active && _lv_area_intersect(&line, &line, area)) {
+            zmk_compositor_fill(&line, true);
+        }
+    }
+}
+
+static void modifiers_update_cb(struct modifiers_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_MODIFIERS);
+
+    if (WIDGET_STATE_CHANGED(&modifiers_cache, state, modifiers)) {
+        WIDGET_STATE_SAVE(&modifiers_cache, state);
+        draw_modifiers(state);
+        zmk_compositor_commit();
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_MODIFIERS);
+}
+
+static struct modifiers_state modifiers_get_state(const zmk_event_t *eh) {
+    const struct zmk_explicit_mods_changed *ev = as_zmk_explicit_mods_changed(eh);
+    return (struct modifiers_state){
+        .modifiers = (ev != NULL) ? ev->modifiers : zmk_hid_get_explicit_mods(),
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(compositor_modifiers, struct modifiers_state, modifiers_update_cb,
+                            modifiers_get_state)
+ZMK_SUBSCRIPTION(compositor_modifiers, zmk_explicit_mods_changed);
+
+// peripheral battery
+
+static const lv_area_t battery_status_area = WIDGET_AREA(battery_status);
+static WIDGET_STATE(struct peripheral_battery_state)
+    battery_status_cache[ZMK_SPLIT_BLE_PERIPHERAL_COUNT];
+
+static void draw_battery_status(struct peripheral_battery_state state) {
+    const lv_area_t *area = &battery_status_area;
+    // one 8 row display page per peripheral, the 5x8 icon right aligned and the level left of it
+    lv_coord_t y = area->y1 + state.source * 8;
+    lv_area_t row = {area->x1, y, area->x2, y + 7};
+    lv_area_t icon = {row.x2 - 4, row.y1, row.x2, row.y2};
+    lv_area_t label = {row.x1, row.y1, row.x2 - 7, row.y2};
+    char text[5];
+
+    zmk_compositor_fill(&row, false);
+
+    // hidden until the peripheral reports a level
+    if (state.level == 0) {
+        return;
+    }
+
+    zmk_compositor_draw_img(&icon, icon.x1, icon.y1,
+                            battery_glyphs[battery_level_glyph(state.level)]);
+
+    snprintf(text, sizeof(text), "%3u%%", state.level);
+    zmk_compositor_draw_text(&label, text, true);
+}
+
+static void battery_status_update_cb(struct peripheral_battery_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_BATTERY_STATUS);
+
+    if (state.source < ZMK_SPLIT_BLE_PERIPHERAL_COUNT &&
+        WIDGET_STATE_CHANGED(&battery_status_cache[state.source], state, level)) {
+        WIDGET_STATE_SAVE(&battery_status_cache[state.source], state);
+        draw_battery_status(state);
+        zmk_compositor_commit();
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_BATTERY_STATUS);
+}
+
+static struct peripheral_battery_state battery_status_get_state(const zmk_event_t *eh) {
+    const struct zmk_peripheral_battery_state_changed *ev =
+        as_zmk_peripheral_battery_state_changed(eh);
+    return (struct peripheral_battery_state){
+        .source = ev != NULL ? ev->source : 0,
+        .level = ev != NULL ? ev->state_of_charge : 0,
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(compositor_battery_status, struct peripheral_battery_state,
+                            battery_status_update_cb, battery_status_get_state)
+ZMK_SUBSCRIPTION(compositor_battery_status, zmk_peripheral_battery_state_changed);
+
+// local battery
+
+#if IS_ENABLED(CONFIG_ARIXA_BATTERY_GAUGE)
+
+static const lv_area_t local_battery_area = WIDGET_AREA(local_battery);
+static WIDGET_STATE(struct local_battery_state) local_battery_cache;
+
+static void draw_local_battery(struct local_battery_state state) {
+    const lv_area_t *area = &local_battery_area;
+    // level on the first display page like a peripheral row, time to empty on the second
+    lv_area_t icon = {area->x2 - 4, area->y1, area->x2, area->y1 + 7};
+    lv_area_t label = {area->x1, area->y1, area->x2 - 7, area->y1 + 7};
+    lv_area_t time = {area->x1, area->y1 + 8, area->x2 - 7, area->y1 + 15};
+    char text[5];
+
+    zmk_compositor_fill(&icon, false);
+    zmk_compositor_draw_img(&icon, icon.x1, icon.y1,
+                            battery_glyphs[battery_level_glyph(state.level)]);
+
+    snprintf(text, sizeof(text), "%3u%%", state.level);
+    zmk_compositor_draw_text(&label, text, true);
+
+    local_battery_time_text(text, sizeof(text), state);
+    zmk_compositor_draw_text(&time, text, true);
+}
+
+static void local_battery_update_cb(struct local_battery_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_LOCAL_BATTERY);
+
+    // hidden until the gauge has a reading
+    if (state.valid && (WIDGET_STATE_CHANGED(&local_battery_cache, state, level) ||
+                        WIDGET_STATE_CHANGED(&local_battery_cache, state, charging) ||
+                        WIDGET_STATE_CHANGED(&local_battery_cache, state, minutes_to_empty))) {
+        WIDGET_STATE_SAVE(&local_battery_cache, state);
+        draw_local_battery(state);
+        zmk_compositor_commit();
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_LOCAL_BATTERY);
+}
+
+static struct local_battery_state local_battery_get_state(const zmk_event_t *eh) {
+    const struct zmk_battery_gauge_changed *ev = as_zmk_battery_gauge_changed(eh);
+    struct zmk_battery_gauge_state gauge = ev != NULL ? ev->state : zmk_battery_gauge_get_state();
+
+    return (struct local_battery_state){
+        .valid = gauge.millivolts > 0,
+        .level = gauge.state_of_charge,
+        .charging = gauge.charging,
+        .minutes_to_empty = gauge.minutes_to_empty,
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(compositor_local_battery, struct local_battery_state,
+                            local_battery_update_cb, local_battery_get_state)
+ZMK_SUBSCRIPTION(compositor_local_battery, zmk_battery_gauge_changed);
+
+#endif
+
+// power estimate
+
+#if IS_ENABLED(CONFIG_ARIXA_POWER_MODEL)
+
+static const lv_area_t power_status_area = WIDGET_AREA(power_status);
+static WIDGET_STATE(struct power_status_state) power_status_cache;
+
+static void power_status_update_cb(struct power_status_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_POWER_STATUS);
+
+    // blank until the first accounting window closes, then only tenths of a mA are shown
+    if (state.microamps > 0 && (!power_status_cache.valid ||
+                                power_status_cache.last.microamps / 100 != state.microamps / 100)) {
+        char text[6];
+
+        WIDGET_STATE_SAVE(&power_status_cache, state);
+        power_status_text(text, sizeof(text), state);
+        zmk_compositor_draw_text(&power_status_area, text, false);
+        zmk_compositor_commit();
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_POWER_STATUS);
+}
+
+static struct power_status_state power_status_get_state(const zmk_event_t *eh) {
+    const struct zmk_power_estimate_changed *ev = as_zmk_power_estimate_changed(eh);
+    struct zmk_power_estimate estimate =
+        ev != NULL ? ev->estimate : zmk_power_model_get_estimate();
+
+    return (struct power_status_state){
+        .microamps = estimate.total_microamps,
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(compositor_power_status, struct power_status_state,
+                            power_status_update_cb, power_status_get_state)
+ZMK_SUBSCRIPTION(compositor_power_status, zmk_power_estimate_changed);
+
+#endif
+
+// key latency
+
+#if IS_ENABLED(CONFIG_ARIXA_KEY_LATENCY_PROBE)
+
+static const lv_area_t latency_status_area = WIDGET_AREA(latency_status);
+static WIDGET_STATE(struct latency_status_state) latency_status_cache;
+
+static void latency_status_update_cb(struct latency_status_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_LATENCY_STATUS);
+
+    // blank until the first window of presses, then only tenths of a ms are shown
+    if (state.avg_us > 0 && (!latency_status_cache.valid ||
+                             latency_status_cache.last.avg_us / 100 != state.avg_us / 100)) {
+        char text[6];
+
+        WIDGET_STATE_SAVE(&latency_status_cache, state);
+        latency_status_text(text, sizeof(text), state);
+        zmk_compositor_draw_text(&latency_status_area, text, false);
+        zmk_compositor_commit();
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_LATENCY_STATUS);
+}
+
+static struct latency_status_state latency_status_get_state(const zmk_event_t *eh) {
+    const struct zmk_key_latency_changed *ev = as_zmk_key_latency_changed(eh);
+
+    return (struct latency_status_state){
+        .avg_us = ev != NULL ? ev->avg_us : 0,
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(compositor_latency_status, struct latency_status_state,
+                            latency_status_update_cb, latency_status_get_state)
+ZMK_SUBSCRIPTION(compositor_latency_status, zmk_key_latency_changed);
+
+#endif
+
+// layer
+
+static const lv_area_t layer_status_area = WIDGET_AREA(layer_status);
+static WIDGET_STATE(struct layer_status_state) layer_status_cache;
+
+static void layer_status_update_cb(struct layer_status_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_LAYER_STATUS);
+
+    if (WIDGET_STATE_CHANGED(&layer_status_cache, state, index) ||
+        WIDGET_STATE_CHANGED(&layer_status_cache, state, label)) {
+        char text[13];
+
+        WIDGET_STATE_SAVE(&layer_status_cache, state);
+        if (state.label == NULL) {
+            snprintf(text, sizeof(text), "%i", state.index);
+        } else {
+            snprintf(text, sizeof(text), "%s", state.label);
+        }
+
+        // long names are cut at the box edge, like the clipped LVGL label
+        zmk_compositor_draw_text(&layer_status_area, text, false);
+        zmk_compositor_commit();
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_LAYER_STATUS);
+}
+
+static struct layer_status_state layer_status_get_state(const zmk_event_t *eh) {
+    uint8_t index = zmk_keymap_highest_layer_active();
+    return (struct layer_status_state){
+        .index = index,
+        .label = layer_status_label(index),
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(compositor_layer_status, struct layer_status_state,
+                            layer_status_update_cb, layer_status_get_state)
+ZMK_SUBSCRIPTION(compositor_layer_status, zmk_layer_state_changed);
+
+// HID indicators
+
+#if IS_ENABLED(CONFIG_ZMK_HID_INDICATORS)
+
+#define LED_NLCK 0x01
+#define LED_CLCK 0x02
+#define LED_SLCK 0x04
+
+static const lv_area_t hid_indicators_area = WIDGET_AREA(hid_indicators);
+static WIDGET_STATE(struct hid_indicators_state) hid_indicators_cache;
+
+static void hid_indicators_update_cb(struct hid_indicators_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_HID_INDICATORS);
+
+    if (WIDGET_STATE_CHANGED(&hid_indicators_cache, state, hid_indicators)) {
+        char text[7] = {};
+
+        WIDGET_STATE_SAVE(&hid_indicators_cache, state);
+        if (state.hid_indicators & LED_CLCK) {
+            strcat(text, "C");
+        }
+        if (state.hid_indicators & LED_NLCK) {
+            strcat(text, "N");
+        }
+        if (state.hid_indicators & LED_SLCK) {
+            strcat(text, "S");
+        }
+        if (text[0] != '\0') {
+            strcat(text, "LCK");
+        }
+
+        zmk_compositor_draw_text(&hid_indicators_area, text, false);
+        zmk_compositor_commit();
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_HID_INDICATORS);
+}
+
+static struct hid_indicators_state hid_indicators_get_state(const zmk_event_t *eh) {
+    const struct zmk_hid_indicators_changed *ev = as_zmk_hid_indicators_changed(eh);
+    return (struct hid_indicators_state){
+        .hid_indicators = ev != NULL ? ev->indicators : 0,
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(compositor_hid_indicators, struct hid_indicators_state,
+                            hid_indicators_update_cb, hid_indicators_get_state)
+ZMK_SUBSCRIPTION(compositor_hid_indicators, zmk_hid_indicators_changed);
+
+#endif
+
+// bongo cat, paws follow key presses like ARIXA_BONGO_CAT_KEYSTROKE
+
+static const lv_area_t bongo_cat_area = WIDGET_AREA(bongo_cat);
+static uint8_t bongo_cat_pixels[BONGO_CAT_DATA_SIZE];
+static enum bongo_cat_frame_id bongo_cat_frame = BONGO_CAT_KEYFRAME;
+
+static struct bongo_cat_key_state bongo_cat_keys;
+static uint32_t bongo_cat_rendered_presses;
+static bool bongo_cat_right_paw_next;
+
+static void show_bongo_cat_frame(enum bongo_cat_frame_id id) {
+    if (id == bongo_cat_frame) {
+        return;
+    }
+
+    bongo_cat_apply_delta(bongo_cat_pixels, &bongo_cat_frames[bongo_cat_frame]);
+    bongo_cat_apply_delta(bongo_cat_pixels, &bongo_cat_frames[id]);
+    bongo_cat_frame = id;
+
+    zmk_compositor_draw_pages(bongo_cat_area.x1, bongo_cat_area.y1, BONGO_CAT_WIDTH,
+                              BONGO_CAT_HEIGHT, bongo_cat_pixels, BONGO_CAT_STRIDE);
+    zmk_compositor_commit();
+}
+
+static void bongo_cat_rest_work_cb(struct k_work *work) {
+    show_bongo_cat_frame(BONGO_CAT_KEYFRAME);
+}
+
+static K_WORK_DELAYABLE_DEFINE(bongo_cat_rest_work, bongo_cat_rest_work_cb);
+
+static void bongo_cat_update_cb(struct bongo_cat_key_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_BONGO_CAT);
+
+    if (state.presses != bongo_cat_rendered_presses) {
+        bongo_cat_rendered_presses = state.presses;
+        show_bongo_cat_frame(bongo_cat_right_paw_next ? BONGO_CAT_FRAME_RIGHT1
+                                                      : BONGO_CAT_FRAME_LEFT1);
+        bongo_cat_right_paw_next = !bongo_cat_right_paw_next;
+    } else if (state.held == 0 && bongo_cat_frame != BONGO_CAT_KEYFRAME) {
+        show_bongo_cat_frame(BONGO_CAT_FRAME_NONE);
+    }
+
+    if (state.held > 0) {
+        k_work_cancel_delayable(&bongo_cat_rest_work);
+    } else {
+        k_work_reschedule_for_queue(zmk_display_work_q(), &bongo_cat_rest_work,
+                                    K_MSEC(CONFIG_ARIXA_BONGO_CAT_REST_DELAY_MS));
+    }
+
+    RENDER_PROFILE_END(RENDER_PROFILE_BONGO_CAT);
+}
+
+static struct bongo_cat_key_state bongo_cat_get_state(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+
+    if (ev != NULL) {
+        if (ev->state) {
+            bongo_cat_keys.presses++;
+            bongo_cat_keys.held++;
+        } else if (bongo_cat_keys.held > 0) {
+            bongo_cat_keys.held--;
+        }
+    }
+
+    return bongo_cat_keys;
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(compositor_bongo_cat, struct bongo_cat_key_state, bongo_cat_update_cb,
+                            bongo_cat_get_state)
+ZMK_SUBSCRIPTION(compositor_bongo_cat, zmk_position_state_changed);
+
+void zmk_compositor_widgets_init() {
+    memcpy(bongo_cat_pixels, bongo_cat_keyframe, BONGO_CAT_DATA_SIZE);
+    zmk_compositor_draw_pages(bongo_cat_area.x1, bongo_cat_area.y1, BONGO_CAT_WIDTH,
+                              BONGO_CAT_HEIGHT, bongo_cat_pixels, BONGO_CAT_STRIDE);
+
+    compositor_output_status_init();
+    compositor_modifiers_init();
+    compositor_battery_status_init();
+#if IS_ENABLED(CONFIG_ARIXA_BATTERY_GAUGE)
+    compositor_local_battery_init();
+#endif
+#if IS_ENABLED(CONFIG_ARIXA_POWER_MODEL)
+    compositor_power_status_init();
+#endif
+#if IS_ENABLED(CONFIG_ARIXA_KEY_LATENCY_PROBE)
+    compositor_latency_status_init();
+#endif
+    compositor_layer_status_init();
+#if IS_ENABLED(CONFIG_ZMK_HID_INDICATORS)
+    compositor_hid_indicators_init();
+#endif
+    compositor_bongo_cat_init();
+
+    zmk_compositor_commit();
+}
@@ -0,0 +1,10 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Draws the status screen widgets through the framebuffer compositor and keeps them updated.
+void zmk_compositor_widgets_init();
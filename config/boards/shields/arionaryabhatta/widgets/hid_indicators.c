@@ -13,23 +13,26 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/display.h>
 #include <zmk/event_manager.h>
 #include <zmk/events/hid_indicators_changed.h>
+#include <zmk/hid_indicators.h>
 
 #include "hid_indicators.h"
+#include "../render_profile.h"
 
 #define LED_NLCK 0x01
 #define LED_CLCK 0x02
 #define LED_SLCK 0x04
 
-struct hid_indicators_state {    
-    uint8_t hid_indicators;
-};
-
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
-static void set_hid_indicators(lv_obj_t *label, struct hid_indicators_state state) {
+static void set_hid_indicators(struct zmk_widget_hid_indicators *widget, struct hid_indicators_state state) {
     char text[7] = {};
     bool lock = false;
 
+    if (!WIDGET_STATE_CHANGED(&widget->state, state, hid_indicators)) {
+        return;
+    }
+    WIDGET_STATE_SAVE(&widget->state, state);
+
     if (state.hid_indicators & LED_CLCK) {
         strncat(text, "C", 1);
         lock = true;
@@ -46,18 +49,20 @@ static void set_hid_indicators(lv_obj_t *label, struct hid_indicators_state stat
         strncat(text, "LCK", 3);
     }
 
-    lv_label_set_text(label, text);
+    lv_label_set_text(widget->obj, text);
 }
 
 void hid_indicators_update_cb(struct hid_indicators_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_HID_INDICATORS);
     struct zmk_widget_hid_indicators *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_hid_indicators(widget->obj, state); }
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_hid_indicators(widget, state); }
+    RENDER_PROFILE_END(RENDER_PROFILE_HID_INDICATORS);
 }
 
 static struct hid_indicators_state hid_indicators_get_state(const zmk_event_t *eh) {
     struct zmk_hid_indicators_changed *ev = as_zmk_hid_indicators_changed(eh);
     return (struct hid_indicators_state) {
-        .hid_indicators = ev->indicators,
+        .hid_indicators = (ev != NULL) ? ev->indicators : zmk_hid_indicators_get_current_profile(),
     };
 }
 
@@ -68,6 +73,7 @@ ZMK_SUBSCRIPTION(widget_hid_indicators, zmk_hid_indicators_changed);
 
 int zmk_widget_hid_indicators_init(struct zmk_widget_hid_indicators *widget, lv_obj_t *parent) {
     widget->obj = lv_label_create(parent);
+    widget->state.valid = false;
 
     sys_slist_append(&widgets, &widget->node);
 
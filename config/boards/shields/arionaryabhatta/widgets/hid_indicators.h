@@ -9,9 +9,16 @@
 #include <lvgl.h>
 #include <zephyr/kernel.h>
 
+#include "widget_state.h"
+
+struct hid_indicators_state {
+    uint8_t hid_indicators;
+};
+
 struct zmk_widget_hid_indicators {
     sys_snode_t node;
     lv_obj_t *obj;
+    WIDGET_STATE(struct hid_indicators_state) state;
 };
 
 int zmk_widget_hid_indicators_init(struct zmk_widget_hid_indicators *widget, lv_obj_t *parent);
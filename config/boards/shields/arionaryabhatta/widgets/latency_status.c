@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+
+#include "latency_status.h"
+#include "../render_profile.h"
+#include "../events/key_latency_changed.h"
+
+static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+
+static void set_latency_status(struct zmk_widget_latency_status *widget,
+                               struct latency_status_state state) {
+    char text[6];
+
+    // blank until the first window of presses, then only tenths of a ms are shown
+    if (state.avg_us == 0 ||
+        (widget->state.valid && widget->state.last.avg_us / 100 == state.avg_us / 100)) {
+        return;
+    }
+    WIDGET_STATE_SAVE(&widget->state, state);
+
+    latency_status_text(text, sizeof(text), state);
+    lv_label_set_text(widget->obj, text);
+}
+
+void latency_status_update_cb(struct latency_status_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_LATENCY_STATUS);
+    struct zmk_widget_latency_status *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_latency_status(widget, state); }
+    RENDER_PROFILE_END(RENDER_PROFILE_LATENCY_STATUS);
+}
+
+static struct latency_status_state latency_status_get_state(const zmk_event_t *eh) {
+    const struct zmk_key_latency_changed *ev = as_zmk_key_latency_changed(eh);
+
+    return (struct latency_status_state){
+        .avg_us = ev != NULL ? ev->avg_us : 0,
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_latency_status, struct latency_status_state,
+                            latency_status_update_cb, latency_status_get_state)
+
+ZMK_SUBSCRIPTION(widget_latency_status, zmk_key_latency_changed);
+
+int zmk_widget_latency_status_init(struct zmk_widget_latency_status *widget, lv_obj_t *parent) {
+    widget->obj = lv_label_create(parent);
+    widget->state.valid = false;
+
+    sys_slist_append(&widgets, &widget->node);
+
+    widget_latency_status_init();
+
+    return 0;
+}
+
+lv_obj_t *zmk_widget_latency_status_obj(struct zmk_widget_latency_status *widget) {
+    return widget->obj;
+}
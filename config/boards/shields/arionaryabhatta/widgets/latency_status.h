@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+#include <stdio.h>
+
+#include "widget_state.h"
+
+struct latency_status_state {
+    uint32_t avg_us;
+};
+
+struct zmk_widget_latency_status {
+    sys_snode_t node;
+    lv_obj_t *obj;
+    WIDGET_STATE(struct latency_status_state) state;
+};
+
+// Average key to report latency in at most 5 characters, tenths of a ms below 10 ms.
+static inline void latency_status_text(char *text, size_t len, struct latency_status_state state) {
+    uint32_t tenths = state.avg_us / 100;
+
+    if (tenths < 100) {
+        snprintf(text, len, "%u.%ums", tenths / 10, tenths % 10);
+    } else {
+        snprintf(text, len, "%ums", MIN(tenths / 10, 999));
+    }
+}
+
+int zmk_widget_latency_status_init(struct zmk_widget_latency_status *widget, lv_obj_t *parent);
+lv_obj_t *zmk_widget_latency_status_obj(struct zmk_widget_latency_status *widget);
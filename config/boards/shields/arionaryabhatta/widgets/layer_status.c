@@ -9,20 +9,25 @@
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #include <zmk/display.h>
-#include <zmk/display/widgets/layer_status.h>
 #include <zmk/events/layer_state_changed.h>
 #include <zmk/event_manager.h>
 #include <zmk/endpoints.h>
 #include <zmk/keymap.h>
 
+#include "layer_status.h"
+#include "../render_profile.h"
+
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
-struct layer_status_state {
-    uint8_t index;
-    const char *label;
-};
+static void set_layer_symbol(struct zmk_widget_layer_status *widget, struct layer_status_state state) {
+    lv_obj_t *label = widget->obj;
+
+    if (!WIDGET_STATE_CHANGED(&widget->state, state, index) &&
+        !WIDGET_STATE_CHANGED(&widget->state, state, label)) {
+        return;
+    }
+    WIDGET_STATE_SAVE(&widget->state, state);
 
-static void set_layer_symbol(lv_obj_t *label, struct layer_status_state state) {
     if (state.label == NULL) {
         char text[7] = {};
 
@@ -39,15 +44,17 @@ static void set_layer_symbol(lv_obj_t *label, struct layer_status_state state) {
 }
 
 static void layer_status_update_cb(struct layer_status_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_LAYER_STATUS);
     struct zmk_widget_layer_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_layer_symbol(widget->obj, state); }
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_layer_symbol(widget, state); }
+    RENDER_PROFILE_END(RENDER_PROFILE_LAYER_STATUS);
 }
 
 static struct layer_status_state layer_status_get_state(const zmk_event_t *eh) {
     uint8_t index = zmk_keymap_highest_layer_active();
     return (struct layer_status_state) {
         .index = index,
-        .label = zmk_keymap_layer_name(index)
+        .label = layer_status_label(index)
     };
 }
 
@@ -58,6 +65,10 @@ ZMK_SUBSCRIPTION(widget_layer_status, zmk_layer_state_changed);
 
 int zmk_widget_layer_status_init(struct zmk_widget_layer_status *widget, lv_obj_t *parent) {
     widget->obj = lv_label_create(parent);
+    widget->state.valid = false;
+
+    // the status layout gives the label a fixed box, long names are cut rather than wrapped
+    lv_label_set_long_mode(widget->obj, LV_LABEL_LONG_CLIP);
 
     sys_slist_append(&widgets, &widget->node);
 
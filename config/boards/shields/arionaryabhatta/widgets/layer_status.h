@@ -8,10 +8,36 @@
 
 #include <lvgl.h>
 #include <zephyr/kernel.h>
+#include <zmk/keymap.h>
+
+#include "widget_state.h"
+
+struct layer_status_state {
+    uint8_t index;
+    const char *label;
+};
+
+LV_FONT_DECLARE(arixa_font_8);
+
+// The keymap name of layer index, or NULL when it has none or it has characters arixa_font_8 was
+// not subset with, as a name renamed through ZMK Studio can, so the number is shown instead.
+static inline const char *layer_status_label(uint8_t index) {
+    const char *name = zmk_keymap_layer_name(index);
+    lv_font_glyph_dsc_t glyph;
+
+    for (const char *c = name; c != NULL && *c != '\0'; c++) {
+        if (!lv_font_get_glyph_dsc(&arixa_font_8, &glyph, (uint8_t)*c, 0)) {
+            return NULL;
+        }
+    }
+
+    return name;
+}
 
 struct zmk_widget_layer_status {
     sys_snode_t node;
     lv_obj_t *obj;
+    WIDGET_STATE(struct layer_status_state) state;
 };
 
 int zmk_widget_layer_status_init(struct zmk_widget_layer_status *widget, lv_obj_t *parent);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+
+#include "local_battery.h"
+#include "battery_status.h"
+#include "../render_profile.h"
+#include "../battery_gauge.h"
+#include "../events/battery_gauge_changed.h"
+
+static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+
+static void set_local_battery(struct zmk_widget_local_battery *widget,
+                              struct local_battery_state state) {
+    lv_obj_t *symbol = lv_obj_get_child(widget->obj, 0);
+    lv_obj_t *label = lv_obj_get_child(widget->obj, 1);
+    lv_obj_t *time = lv_obj_get_child(widget->obj, 2);
+    bool was_shown = widget->state.valid && widget->state.last.valid;
+    char text[5];
+
+    if (!state.valid) {
+        return;
+    }
+
+    // the image only changes with the fill bucket, the labels with their own fields
+    if (!was_shown ||
+        battery_level_glyph(widget->state.last.level) != battery_level_glyph(state.level)) {
+        lv_img_set_src(symbol, battery_glyphs[battery_level_glyph(state.level)]);
+    }
+    if (WIDGET_STATE_CHANGED(&widget->state, state, level)) {
+        lv_label_set_text_fmt(label, "%3u%%", state.level);
+    }
+    if (WIDGET_STATE_CHANGED(&widget->state, state, charging) ||
+        WIDGET_STATE_CHANGED(&widget->state, state, minutes_to_empty)) {
+        local_battery_time_text(text, sizeof(text), state);
+        lv_label_set_text(time, text);
+    }
+    WIDGET_STATE_SAVE(&widget->state, state);
+
+    if (!was_shown) {
+        lv_obj_clear_flag(symbol, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(label, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(time, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void local_battery_update_cb(struct local_battery_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_LOCAL_BATTERY);
+    struct zmk_widget_local_battery *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_local_battery(widget, state); }
+    RENDER_PROFILE_END(RENDER_PROFILE_LOCAL_BATTERY);
+}
+
+static struct local_battery_state local_battery_get_state(const zmk_event_t *eh) {
+    const struct zmk_battery_gauge_changed *ev = as_zmk_battery_gauge_changed(eh);
+    struct zmk_battery_gauge_state gauge = ev != NULL ? ev->state : zmk_battery_gauge_get_state();
+
+    return (struct local_battery_state){
+        .valid = gauge.millivolts > 0,
+        .level = gauge.state_of_charge,
+        .charging = gauge.charging,
+        .minutes_to_empty = gauge.minutes_to_empty,
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_local_battery, struct local_battery_state,
+                            local_battery_update_cb, local_battery_get_state)
+
+ZMK_SUBSCRIPTION(widget_local_battery, zmk_battery_gauge_changed);
+
+int zmk_widget_local_battery_init(struct zmk_widget_local_battery *widget, lv_obj_t *parent) {
+    widget->obj = lv_obj_create(parent);
+    widget->state.valid = false;
+
+    lv_obj_t *battery_image = lv_img_create(widget->obj);
+    lv_obj_t *battery_label = lv_label_create(widget->obj);
+    lv_obj_t *time_label = lv_label_create(widget->obj);
+
+    // hidden until the gauge has a reading
+    lv_obj_add_flag(battery_image, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(battery_label, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(time_label, LV_OBJ_FLAG_HIDDEN);
+
+    // level on the first display page like a peripheral row, time to empty on the second
+    lv_obj_align(battery_image, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_obj_align(battery_label, LV_ALIGN_TOP_RIGHT, -7, 0);
+    lv_obj_align(time_label, LV_ALIGN_TOP_RIGHT, -7, 8);
+
+    sys_slist_append(&widgets, &widget->node);
+
+    widget_local_battery_init();
+
+    return 0;
+}
+
+lv_obj_t *zmk_widget_local_battery_obj(struct zmk_widget_local_battery *widget) {
+    return widget->obj;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+#include <stdio.h>
+
+#include "widget_state.h"
+
+struct local_battery_state {
+    bool valid; // false until the gauge has read the cell
+    uint8_t level;
+    bool charging;
+    uint16_t minutes_to_empty;
+};
+
+struct zmk_widget_local_battery {
+    sys_snode_t node;
+    lv_obj_t *obj;
+    WIDGET_STATE(struct local_battery_state) state;
+};
+
+// Time to empty in at most 4 characters, the second line of the widget.
+static inline void local_battery_time_text(char *text, size_t len,
+                                           struct local_battery_state state) {
+    if (state.charging) {
+        snprintf(text, len, "CHG");
+    } else if (state.minutes_to_empty == 0) {
+        snprintf(text, len, "--");
+    } else if (state.minutes_to_empty < 120) {
+        snprintf(text, len, "%um", state.minutes_to_empty);
+    } else if (state.minutes_to_empty < 100 * 60) {
+        snprintf(text, len, "%uh", state.minutes_to_empty / 60);
+    } else {
+        snprintf(text, len, "99h+");
+    }
+}
+
+int zmk_widget_local_battery_init(struct zmk_widget_local_battery *widget, lv_obj_t *parent);
+lv_obj_t *zmk_widget_local_battery_obj(struct zmk_widget_local_battery *widget);
@@ -12,15 +12,13 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #include <zmk/display.h>
 #include <zmk/event_manager.h>
-#include <zmk/events/keycode_state_changed.h>
 #include <zmk/hid.h>
 #include <dt-bindings/zmk/modifiers.h>
 
 #include "modifiers.h"
-
-struct modifiers_state {    
-    uint8_t modifiers;
-};
+#include "../events/explicit_mods_changed.h"
+#include "../anim_governor.h"
+#include "../render_profile.h"
 
 struct modifier_symbol {    
     uint8_t modifier;
@@ -90,10 +88,15 @@ static void move_object_y(void *obj, int32_t from, int32_t to) {
     lv_anim_set_exec_cb(&a, anim_y_cb);
     lv_anim_set_path_cb(&a, lv_anim_path_overshoot);
     lv_anim_set_values(&a, from, to);
-    lv_anim_start(&a);
+    zmk_anim_governor_start(&a);
 }
 
-static void set_modifiers(lv_obj_t *widget, struct modifiers_state state) {
+static void set_modifiers(struct zmk_widget_modifiers *widget, struct modifiers_state state) {
+    if (!WIDGET_STATE_CHANGED(&widget->state, state, modifiers)) {
+        return;
+    }
+    WIDGET_STATE_SAVE(&widget->state, state);
+
     for (int i = 0; i < NUM_SYMBOLS; i++) {
         bool mod_is_active = (state.modifiers & modifier_symbols[i]->modifier) > 0;
 
@@ -110,23 +113,27 @@ static void set_modifiers(lv_obj_t *widget, struct modifiers_state state) {
 }
 
 void modifiers_update_cb(struct modifiers_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_MODIFIERS);
     struct zmk_widget_modifiers *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_modifiers(widget->obj, state); }
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_modifiers(widget, state); }
+    RENDER_PROFILE_END(RENDER_PROFILE_MODIFIERS);
 }
 
 static struct modifiers_state modifiers_get_state(const zmk_event_t *eh) {
+    const struct zmk_explicit_mods_changed *ev = as_zmk_explicit_mods_changed(eh);
     return (struct modifiers_state) {
-        .modifiers = zmk_hid_get_explicit_mods()
+        .modifiers = (ev != NULL) ? ev->modifiers : zmk_hid_get_explicit_mods()
     };
 }
 
 ZMK_DISPLAY_WIDGET_LISTENER(widget_modifiers, struct modifiers_state,
                             modifiers_update_cb, modifiers_get_state)
 
-ZMK_SUBSCRIPTION(widget_modifiers, zmk_keycode_state_changed);
+ZMK_SUBSCRIPTION(widget_modifiers, zmk_explicit_mods_changed);
 
 int zmk_widget_modifiers_init(struct zmk_widget_modifiers *widget, lv_obj_t *parent) {
     widget->obj = lv_obj_create(parent);
+    widget->state.valid = false;
 
     lv_obj_set_size(widget->obj, NUM_SYMBOLS * (SIZE_SYMBOLS + 1) + 1, SIZE_SYMBOLS + 3);
     
@@ -144,7 +151,7 @@ int zmk_widget_modifiers_init(struct zmk_widget_modifiers *widget, lv_obj_t *par
         modifier_symbols[i]->selection_line = lv_line_create(widget->obj);
         lv_line_set_points(modifier_symbols[i]->selection_line, selection_line_points, 2);
         lv_obj_add_style(modifier_symbols[i]->selection_line, &style_line, 0);
-        lv_obj_align_to(modifier_symbols[i]->selection_line, modifier_symbols[i]->symbol, LV_ALIGN_OUT_BOTTOM_LEFT, 0, 3);
+        lv_obj_set_pos(modifier_symbols[i]->selection_line, 1 + (SIZE_SYMBOLS + 1) * i, SIZE_SYMBOLS + 4);
     }
 
     sys_slist_append(&widgets, &widget->node);
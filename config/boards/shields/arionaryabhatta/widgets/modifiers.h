@@ -10,11 +10,18 @@
 #include <zephyr/kernel.h>
 #include <dt-bindings/zmk/modifiers.h>
 
+#include "widget_state.h"
+
 #define SIZE_SYMBOLS 14 // 14 x 14 pixel
 
+struct modifiers_state {
+    uint8_t modifiers;
+};
+
 struct zmk_widget_modifiers {
     sys_snode_t node;
     lv_obj_t *obj;
+    WIDGET_STATE(struct modifiers_state) state;
 };
 
 int zmk_widget_modifiers_init(struct zmk_widget_modifiers *widget, lv_obj_t *parent);
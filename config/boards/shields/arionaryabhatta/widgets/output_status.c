@@ -19,6 +19,8 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 #include <zmk/endpoints.h>
 
 #include "output_status.h"
+#include "../anim_governor.h"
+#include "../render_profile.h"
 
 static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
 
@@ -57,14 +59,6 @@ enum selection_line_state {
 
 lv_point_t selection_line_points[] = { {-1, 0}, {12, 0} }; // will be replaced with  
 
-struct output_status_state {
-    struct zmk_endpoint_instance selected_endpoint;
-    int active_profile_index;
-    bool active_profile_connected;
-    bool active_profile_bonded;
-    bool usb_is_hid_ready;
-};
-
 static struct output_status_state get_state(const zmk_event_t *_eh) {
     return (struct output_status_state){
         .selected_endpoint = zmk_endpoints_selected(),
@@ -91,7 +85,7 @@ static void move_object_x(void *obj, int32_t from, int32_t to) {
     lv_anim_set_exec_cb(&a, anim_x_cb);
     lv_anim_set_path_cb(&a, lv_anim_path_overshoot);
     lv_anim_set_values(&a, from, to);
-    lv_anim_start(&a);
+    zmk_anim_governor_start(&a);
 }
 
 static void change_size_object(void *obj, int32_t from, int32_t to) {
@@ -102,16 +96,16 @@ static void change_size_object(void *obj, int32_t from, int32_t to) {
     lv_anim_set_exec_cb(&a, anim_size_cb);
     lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
     lv_anim_set_values(&a, from, to);
-    lv_anim_start(&a);
+    zmk_anim_governor_start(&a);
 }
 
-static void set_status_symbol(lv_obj_t *widget, struct output_status_state state) {
-    lv_obj_t *usb = lv_obj_get_child(widget, output_symbol_usb);
-    lv_obj_t *usb_hid_status = lv_obj_get_child(widget, output_symbol_usb_hid_status);
-    lv_obj_t *bt = lv_obj_get_child(widget, output_symbol_bt);
-    lv_obj_t *bt_number = lv_obj_get_child(widget, output_symbol_bt_number);
-    lv_obj_t *bt_status = lv_obj_get_child(widget, output_symbol_bt_status);
-    lv_obj_t *selection_line = lv_obj_get_child(widget, output_symbol_selection_line);
+static void set_status_symbol(struct zmk_widget_output_status *widget, struct output_status_state state) {
+    lv_obj_t *usb = lv_obj_get_child(widget->obj, output_symbol_usb);
+    lv_obj_t *usb_hid_status = lv_obj_get_child(widget->obj, output_symbol_usb_hid_status);
+    lv_obj_t *bt = lv_obj_get_child(widget->obj, output_symbol_bt);
+    lv_obj_t *bt_number = lv_obj_get_child(widget->obj, output_symbol_bt_number);
+    lv_obj_t *bt_status = lv_obj_get_child(widget->obj, output_symbol_bt_status);
+    lv_obj_t *selection_line = lv_obj_get_child(widget->obj, output_symbol_selection_line);
 
     switch (state.selected_endpoint.transport) {
     case ZMK_TRANSPORT_USB:
@@ -130,32 +124,43 @@ static void set_status_symbol(lv_obj_t *widget, struct output_status_state state
         break;
     }
 
-    if (state.usb_is_hid_ready) {
-        lv_img_set_src(usb_hid_status, &sym_ok);
-    } else {
-        lv_img_set_src(usb_hid_status, &sym_nok);
+    if (WIDGET_STATE_CHANGED(&widget->state, state, usb_is_hid_ready)) {
+        if (state.usb_is_hid_ready) {
+            lv_img_set_src(usb_hid_status, &sym_ok);
+        } else {
+            lv_img_set_src(usb_hid_status, &sym_nok);
+        }
     }
 
-    if (state.active_profile_index < (sizeof(sym_num) / sizeof(lv_img_dsc_t *))) {
-        lv_img_set_src(bt_number, sym_num[state.active_profile_index]);
-    } else {
-        lv_img_set_src(bt_number, &sym_nok);
+    if (WIDGET_STATE_CHANGED(&widget->state, state, active_profile_index)) {
+        if (state.active_profile_index < (sizeof(sym_num) / sizeof(lv_img_dsc_t *))) {
+            lv_img_set_src(bt_number, sym_num[state.active_profile_index]);
+        } else {
+            lv_img_set_src(bt_number, &sym_nok);
+        }
     }
-    
-    if (state.active_profile_bonded) {
-        if (state.active_profile_connected) {
-            lv_img_set_src(bt_status, &sym_ok);
+
+    if (WIDGET_STATE_CHANGED(&widget->state, state, active_profile_bonded) ||
+        WIDGET_STATE_CHANGED(&widget->state, state, active_profile_connected)) {
+        if (state.active_profile_bonded) {
+            if (state.active_profile_connected) {
+                lv_img_set_src(bt_status, &sym_ok);
+            } else {
+                lv_img_set_src(bt_status, &sym_nok);
+            }
         } else {
-            lv_img_set_src(bt_status, &sym_nok);
+            lv_img_set_src(bt_status, &sym_open);
         }
-    } else {
-        lv_img_set_src(bt_status, &sym_open);
     }
+
+    WIDGET_STATE_SAVE(&widget->state, state);
 }
 
 static void output_status_update_cb(struct output_status_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_OUTPUT_STATUS);
     struct zmk_widget_output_status *widget;
-    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_status_symbol(widget->obj, state); }
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_status_symbol(widget, state); }
+    RENDER_PROFILE_END(RENDER_PROFILE_OUTPUT_STATUS);
 }
 
 ZMK_DISPLAY_WIDGET_LISTENER(widget_output_status, struct output_status_state,
@@ -166,25 +171,25 @@ ZMK_SUBSCRIPTION(widget_output_status, zmk_usb_conn_state_changed);
 
 int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_obj_t *parent) {
     widget->obj = lv_obj_create(parent);
+    widget->state.valid = false;
 
-    lv_obj_set_size(widget->obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-
+    // fixed offsets, lv_obj_align_to would force a layout pass for every child
     lv_obj_t *usb = lv_img_create(widget->obj);
-    lv_obj_align(usb, LV_ALIGN_TOP_LEFT, 1, 4);
+    lv_obj_set_pos(usb, 1, 4);
     lv_img_set_src(usb, &sym_usb);
 
     lv_obj_t *usb_hid_status = lv_img_create(widget->obj);
-    lv_obj_align_to(usb_hid_status, usb, LV_ALIGN_BOTTOM_LEFT, 2, -7);
+    lv_obj_set_pos(usb_hid_status, 3, 11);
 
     lv_obj_t *bt = lv_img_create(widget->obj);
-    lv_obj_align_to(bt, usb, LV_ALIGN_OUT_RIGHT_TOP, 6, 0);
+    lv_obj_set_pos(bt, 16, 4);
     lv_img_set_src(bt, &sym_bt);
 
     lv_obj_t *bt_number = lv_img_create(widget->obj);
-    lv_obj_align_to(bt_number, bt, LV_ALIGN_OUT_RIGHT_TOP, 2, 7);
+    lv_obj_set_pos(bt_number, 27, 11);
 
     lv_obj_t *bt_status = lv_img_create(widget->obj);
-    lv_obj_align_to(bt_status, bt, LV_ALIGN_OUT_RIGHT_TOP, 2, 1);
+    lv_obj_set_pos(bt_status, 27, 5);
     
     static lv_style_t style_line;
     lv_style_init(&style_line);
@@ -194,7 +199,7 @@ int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_ob
     selection_line = lv_line_create(widget->obj);
     lv_line_set_points(selection_line, selection_line_points, 2);
     lv_obj_add_style(selection_line, &style_line, 0);
-    lv_obj_align_to(selection_line, usb, LV_ALIGN_OUT_TOP_LEFT, 3, -1);
+    lv_obj_set_pos(selection_line, 4, 1);
  
     sys_slist_append(&widgets, &widget->node);
 
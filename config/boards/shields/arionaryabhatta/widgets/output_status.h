@@ -8,10 +8,22 @@
 
 #include <lvgl.h>
 #include <zephyr/kernel.h>
+#include <zmk/endpoints.h>
+
+#include "widget_state.h"
+
+struct output_status_state {
+    struct zmk_endpoint_instance selected_endpoint;
+    int active_profile_index;
+    bool active_profile_connected;
+    bool active_profile_bonded;
+    bool usb_is_hid_ready;
+};
 
 struct zmk_widget_output_status {
     sys_snode_t node;
     lv_obj_t *obj;
+    WIDGET_STATE(struct output_status_state) state;
 };
 
 int zmk_widget_output_status_init(struct zmk_widget_output_status *widget, lv_obj_t *parent);
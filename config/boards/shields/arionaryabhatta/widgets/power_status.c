@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/display.h>
+#include <zmk/event_manager.h>
+
+#include "power_status.h"
+#include "../render_profile.h"
+#include "../power_model.h"
+#include "../events/power_estimate_changed.h"
+
+static sys_slist_t widgets = SYS_SLIST_STATIC_INIT(&widgets);
+
+static void set_power_status(struct zmk_widget_power_status *widget,
+                             struct power_status_state state) {
+    char text[6];
+
+    // blank until the first accounting window closes, then only tenths of a mA are shown
+    if (state.microamps == 0 ||
+        (widget->state.valid && widget->state.last.microamps / 100 == state.microamps / 100)) {
+        return;
+    }
+    WIDGET_STATE_SAVE(&widget->state, state);
+
+    power_status_text(text, sizeof(text), state);
+    lv_label_set_text(widget->obj, text);
+}
+
+void power_status_update_cb(struct power_status_state state) {
+    RENDER_PROFILE_BEGIN(RENDER_PROFILE_POWER_STATUS);
+    struct zmk_widget_power_status *widget;
+    SYS_SLIST_FOR_EACH_CONTAINER(&widgets, widget, node) { set_power_status(widget, state); }
+    RENDER_PROFILE_END(RENDER_PROFILE_POWER_STATUS);
+}
+
+static struct power_status_state power_status_get_state(const zmk_event_t *eh) {
+    const struct zmk_power_estimate_changed *ev = as_zmk_power_estimate_changed(eh);
+    struct zmk_power_estimate estimate =
+        ev != NULL ? ev->estimate : zmk_power_model_get_estimate();
+
+    return (struct power_status_state){
+        .microamps = estimate.total_microamps,
+    };
+}
+
+ZMK_DISPLAY_WIDGET_LISTENER(widget_power_status, struct power_status_state,
+                            power_status_update_cb, power_status_get_state)
+
+ZMK_SUBSCRIPTION(widget_power_status, zmk_power_estimate_changed);
+
+int zmk_widget_power_status_init(struct zmk_widget_power_status *widget, lv_obj_t *parent) {
+    widget->obj = lv_label_create(parent);
+    widget->state.valid = false;
+
+    sys_slist_append(&widgets, &widget->node);
+
+    widget_power_status_init();
+
+    return 0;
+}
+
+lv_obj_t *zmk_widget_power_status_obj(struct zmk_widget_power_status *widget) {
+    return widget->obj;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <lvgl.h>
+#include <zephyr/kernel.h>
+#include <stdio.h>
+
+#include "widget_state.h"
+
+struct power_status_state {
+    uint32_t microamps;
+};
+
+struct zmk_widget_power_status {
+    sys_snode_t node;
+    lv_obj_t *obj;
+    WIDGET_STATE(struct power_status_state) state;
+};
+
+// Estimated total draw in at most 5 characters, tenths of a mA below 10 mA.
+static inline void power_status_text(char *text, size_t len, struct power_status_state state) {
+    uint32_t tenths = state.microamps / 100;
+
+    if (tenths < 100) {
+        snprintf(text, len, "%u.%umA", tenths / 10, tenths % 10);
+    } else {
+        snprintf(text, len, "%umA", MIN(tenths / 10, 999));
+    }
+}
+
+int zmk_widget_power_status_init(struct zmk_widget_power_status *widget, lv_obj_t *parent);
+lv_obj_t *zmk_widget_power_status_obj(struct zmk_widget_power_status *widget);
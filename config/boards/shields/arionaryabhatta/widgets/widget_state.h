@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+// The last state a widget instance has drawn. Update callbacks compare the incoming state
+// field by field and only touch the LVGL objects whose inputs changed, so identical updates
+// invalidate nothing.
+#define WIDGET_STATE(type)                                                                         \
+    struct {                                                                                       \
+        type last;                                                                                 \
+        bool valid;                                                                                \
+    }
+
+#define WIDGET_STATE_CHANGED(cache, state, field)                                                  \
+    (!(cache)->valid || (cache)->last.field != (state).field)
+
+#define WIDGET_STATE_SAVE(cache, state)                                                            \
+    do {                                                                                           \
+        (cache)->last = (state);                                                                   \
+        (cache)->valid = true;                                                                     \
+    } while (0)
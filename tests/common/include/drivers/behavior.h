@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zmk/behavior.h>
+#include <zmk/sensors.h>
+
+// The sensor half of ZMK's behavior driver API.
+
+enum behavior_sensor_binding_process_mode {
+    BEHAVIOR_SENSOR_BINDING_PROCESS_MODE_TRIGGER,
+    BEHAVIOR_SENSOR_BINDING_PROCESS_MODE_DISCARD,
+};
+
+typedef int (*behavior_sensor_keymap_binding_accept_data_callback_t)(
+    struct zmk_behavior_binding *binding, struct zmk_behavior_binding_event event,
+    const struct zmk_sensor_config *sensor_config, size_t channel_data_size,
+    const struct zmk_sensor_channel_data *channel_data);
+
+typedef int (*behavior_sensor_keymap_binding_process_callback_t)(
+    struct zmk_behavior_binding *binding, struct zmk_behavior_binding_event event,
+    enum behavior_sensor_binding_process_mode mode);
+
+struct behavior_driver_api {
+    behavior_sensor_keymap_binding_accept_data_callback_t sensor_binding_accept_data;
+    behavior_sensor_keymap_binding_process_callback_t sensor_binding_process;
+};
+
+#define BEHAVIOR_DT_INST_DEFINE DEVICE_DT_INST_DEFINE
+
+static inline int behavior_sensor_keymap_binding_accept_data(
+    struct zmk_behavior_binding *binding, struct zmk_behavior_binding_event event,
+    const struct zmk_sensor_config *sensor_config, size_t channel_data_size,
+    const struct zmk_sensor_channel_data *channel_data) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    const struct behavior_driver_api *api = dev->api;
+
+    return api->sensor_binding_accept_data(binding, event, sensor_config, channel_data_size,
+                                           channel_data);
+}
+
+static inline int
+behavior_sensor_keymap_binding_process(struct zmk_behavior_binding *binding,
+                                       struct zmk_behavior_binding_event event,
+                                       enum behavior_sensor_binding_process_mode mode) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    const struct behavior_driver_api *api = dev->api;
+
+    return api->sensor_binding_process(binding, event, mode);
+}
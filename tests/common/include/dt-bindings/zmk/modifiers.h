@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#define MOD_LCTL (1 << 0)
+#define MOD_LSFT (1 << 1)
+#define MOD_LALT (1 << 2)
+#define MOD_LGUI (1 << 3)
+#define MOD_RCTL (1 << 4)
+#define MOD_RSFT (1 << 5)
+#define MOD_RALT (1 << 6)
+#define MOD_RGUI (1 << 7)
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+
+#define ZMK_BEHAVIOR_OPAQUE 0
+#define ZMK_BEHAVIOR_TRANSPARENT 1
+
+struct zmk_behavior_binding {
+    const char *behavior_dev;
+    uint32_t param1;
+    uint32_t param2;
+};
+
+struct zmk_behavior_binding_event {
+    int layer;
+    uint32_t position;
+    int64_t timestamp;
+};
+
+static inline const struct device *zmk_behavior_get_binding(const char *name) {
+    return device_get_binding(name);
+}
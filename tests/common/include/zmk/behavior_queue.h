@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/behavior.h>
+
+// Each test supplies this, recording what would be queued.
+int zmk_behavior_queue_add(const struct zmk_behavior_binding_event *event,
+                           const struct zmk_behavior_binding binding, bool press, uint32_t wait);
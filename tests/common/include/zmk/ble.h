@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+// a pad without split halves, as the shield is built
+#define ZMK_SPLIT_BLE_PERIPHERAL_COUNT 0
+
+int zmk_ble_active_profile_index();
+bool zmk_ble_active_profile_is_connected();
+bool zmk_ble_active_profile_is_open();
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+// ZMK's display thread runs the status screen updates on this queue
+struct k_work_q *zmk_display_work_q();
+bool zmk_display_is_initialized();
+int zmk_display_init();
+
+// Same shape as ZMK's: the state is taken in the listener, the widget callback runs on the display
+// work queue, and init does both once with a NULL event.
+#define ZMK_DISPLAY_WIDGET_LISTENER(listener, state_type, cb, state_func)                          \
+    K_MUTEX_DEFINE(listener##_mutex);                                                              \
+    static state_type __##listener##_state;                                                        \
+    static state_type listener##_get_local_state() { return __##listener##_state; };               \
+    static void listener##_refresh_state(const zmk_event_t *eh) {                                  \
+        k_mutex_lock(&listener##_mutex, K_FOREVER);                                                \
+        __##listener##_state = state_func(eh);                                                     \
+        k_mutex_unlock(&listener##_mutex);                                                         \
+    }                                                                                              \
+    static void listener##_work_cb(struct k_work *work) {                                          \
+        k_mutex_lock(&listener##_mutex, K_FOREVER);                                                \
+        state_type state = listener##_get_local_state();                                           \
+        k_mutex_unlock(&listener##_mutex);                                                         \
+        cb(state);                                                                                 \
+    }                                                                                              \
+    K_WORK_DEFINE(listener##_work, listener##_work_cb);                                            \
+    static void listener##_init() {                                                                \
+        listener##_refresh_state(NULL);                                                            \
+        listener##_work_cb(&listener##_work);                                                      \
+    }                                                                                              \
+    static int listener##_cb(const zmk_event_t *eh) {                                              \
+        if (zmk_display_is_initialized()) {                                                        \
+            listener##_refresh_state(eh);                                                          \
+            k_work_submit_to_queue(zmk_display_work_q(), &listener##_work);                        \
+        }                                                                                          \
+        return ZMK_EV_EVENT_BUBBLE;                                                                \
+    }                                                                                              \
+    ZMK_LISTENER(listener, listener##_cb);
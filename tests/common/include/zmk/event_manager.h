@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/iterable_sections.h>
+
+// ZMK's event manager API as the shield sources use it. Events are raised synchronously to every
+// subscriber in turn, there is no capture and release, and as_ also takes the NULL event the
+// display widget listeners pass at init.
+
+typedef struct {
+    const char *name;
+} zmk_event_type;
+
+typedef struct {
+    const zmk_event_type *event;
+    uint8_t last_listener_index;
+} zmk_event_t;
+
+#define ZMK_EV_EVENT_BUBBLE 0
+#define ZMK_EV_EVENT_HANDLED 1
+#define ZMK_EV_EVENT_CAPTURED 2
+
+typedef int (*zmk_listener_callback_t)(const zmk_event_t *eh);
+
+struct zmk_listener {
+    zmk_listener_callback_t callback;
+};
+
+struct zmk_event_subscription {
+    const zmk_event_type *event_type;
+    const struct zmk_listener *listener;
+};
+
+#define ZMK_EVENT_DECLARE(event_type)                                                              \
+    struct event_type##_event {                                                                    \
+        zmk_event_t header;                                                                        \
+        struct event_type data;                                                                    \
+    };                                                                                             \
+    int raise_##event_type(struct event_type data);                                                \
+    struct event_type *as_##event_type(const zmk_event_t *eh);                                     \
+    extern const zmk_event_type zmk_event_##event_type;
+
+#define ZMK_EVENT_IMPL(event_type)                                                                 \
+    const zmk_event_type zmk_event_##event_type = {.name = STRINGIFY(event_type)};                 \
+    int raise_##event_type(struct event_type data) {                                               \
+        struct event_type##_event ev = {.header = {.event = &zmk_event_##event_type},              \
+                                        .data = data};                                             \
+        return zmk_event_manager_raise(&ev.header);                                                \
+    }                                                                                              \
+    struct event_type *as_##event_type(const zmk_event_t *eh) {                                    \
+        return (eh != NULL && eh->event == &zmk_event_##event_type)                                \
+                   ? &((struct event_type##_event *)eh)->data                                      \
+                   : NULL;                                                                         \
+    }
+
+#define ZMK_LISTENER(mod, cb) const struct zmk_listener zmk_listener_##mod = {.callback = cb};
+
+#define ZMK_SUBSCRIPTION(mod, ev_type)                                                             \
+    const STRUCT_SECTION_ITERABLE(zmk_event_subscription,                                          \
+                                  _CONCAT(_CONCAT(zmk_event_sub_, mod), ev_type)) = {              \
+        .event_type = &zmk_event_##ev_type,                                                        \
+        .listener = &zmk_listener_##mod,                                                           \
+    };
+
+int zmk_event_manager_raise(zmk_event_t *event);
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/event_manager.h>
+
+struct zmk_ble_active_profile_changed {
+    uint8_t index;
+};
+
+ZMK_EVENT_DECLARE(zmk_ble_active_profile_changed);
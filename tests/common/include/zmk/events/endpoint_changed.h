@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/endpoints.h>
+#include <zmk/event_manager.h>
+
+struct zmk_endpoint_changed {
+    struct zmk_endpoint_instance endpoint;
+};
+
+ZMK_EVENT_DECLARE(zmk_endpoint_changed);
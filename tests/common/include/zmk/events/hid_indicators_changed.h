@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/hid_indicators.h>
+#include <zmk/event_manager.h>
+
+struct zmk_hid_indicators_changed {
+    zmk_hid_indicators_t indicators;
+};
+
+ZMK_EVENT_DECLARE(zmk_hid_indicators_changed);
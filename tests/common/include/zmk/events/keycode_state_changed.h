@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/event_manager.h>
+
+struct zmk_keycode_state_changed {
+    uint16_t usage_page;
+    uint32_t keycode;
+    uint8_t implicit_modifiers;
+    uint8_t explicit_modifiers;
+    bool state;
+    int64_t timestamp;
+};
+
+ZMK_EVENT_DECLARE(zmk_keycode_state_changed);
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/usb.h>
+#include <zmk/event_manager.h>
+
+struct zmk_usb_conn_state_changed {
+    enum zmk_usb_conn_state conn_state;
+};
+
+ZMK_EVENT_DECLARE(zmk_usb_conn_state_changed);
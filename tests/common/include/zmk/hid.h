@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+typedef uint8_t zmk_mod_flags_t;
+
+zmk_mod_flags_t zmk_hid_get_explicit_mods();
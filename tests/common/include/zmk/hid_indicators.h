@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+typedef uint8_t zmk_hid_indicators_t;
+
+zmk_hid_indicators_t zmk_hid_indicators_get_current_profile();
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+// the shield's keymap has four layers
+#define ZMK_KEYMAP_LAYERS_LEN 4
+
+typedef uint8_t zmk_keymap_layer_id_t;
+typedef uint8_t zmk_keymap_layer_index_t;
+
+zmk_keymap_layer_index_t zmk_keymap_highest_layer_active();
+const char *zmk_keymap_layer_name(zmk_keymap_layer_id_t layer_id);
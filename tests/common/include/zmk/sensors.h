@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/sensor.h>
+
+// the shield has one encoder
+#define ZMK_KEYMAP_SENSORS_LEN 1
+
+struct zmk_sensor_config {
+    uint16_t triggers_per_rotation;
+};
+
+struct zmk_sensor_channel_data {
+    struct sensor_value value;
+    enum sensor_channel channel;
+};
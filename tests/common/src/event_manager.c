@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+
+int zmk_event_manager_raise(zmk_event_t *event) {
+    STRUCT_SECTION_FOREACH(zmk_event_subscription, sub) {
+        if (sub->event_type != event->event) {
+            continue;
+        }
+
+        int ret = sub->listener->callback(event);
+        if (ret < 0) {
+            LOG_ERR("%s listener failed: %d", event->event->name, ret);
+            return ret;
+        }
+        if (ret != ZMK_EV_EVENT_BUBBLE) {
+            return 0;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zmk/events/activity_state_changed.h>
+#include <zmk/events/battery_state_changed.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#include <zmk/events/endpoint_changed.h>
+#include <zmk/events/hid_indicators_changed.h>
+#include <zmk/events/keycode_state_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/position_state_changed.h>
+#include <zmk/events/usb_conn_state_changed.h>
+#include <zmk/events/wpm_state_changed.h>
+
+ZMK_EVENT_IMPL(zmk_activity_state_changed);
+ZMK_EVENT_IMPL(zmk_battery_state_changed);
+ZMK_EVENT_IMPL(zmk_peripheral_battery_state_changed);
+ZMK_EVENT_IMPL(zmk_ble_active_profile_changed);
+ZMK_EVENT_IMPL(zmk_endpoint_changed);
+ZMK_EVENT_IMPL(zmk_hid_indicators_changed);
+ZMK_EVENT_IMPL(zmk_keycode_state_changed);
+ZMK_EVENT_IMPL(zmk_layer_state_changed);
+ZMK_EVENT_IMPL(zmk_position_state_changed);
+ZMK_EVENT_IMPL(zmk_usb_conn_state_changed);
+ZMK_EVENT_IMPL(zmk_wpm_state_changed);
@@ -0,0 +1,9 @@
+# ZMK stand-ins for the native_sim tests: the headers the shield sources include, a synchronous
+# event manager and the events ZMK itself defines. Each test supplies the state behind the getters.
+set(ZMK_TEST_COMMON_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+zephyr_include_directories(${ZMK_TEST_COMMON_DIR}/include)
+zephyr_linker_sources(SECTIONS ${ZMK_TEST_COMMON_DIR}/zmk-events.ld)
+
+target_sources(app PRIVATE ${ZMK_TEST_COMMON_DIR}/src/event_manager.c)
+target_sources(app PRIVATE ${ZMK_TEST_COMMON_DIR}/src/events.c)
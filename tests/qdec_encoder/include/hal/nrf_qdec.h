@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+// The parts of the nrfx QDEC HAL qdec_encoder.c uses, over a register model the test drives. There
+// is one QDEC, so the register block pointer the driver passes in is not dereferenced.
+
+typedef struct {
+    bool enabled;
+    bool started;
+    bool events_reportrdy;
+    bool dbfen;
+    uint32_t shorts;
+    uint32_t intenset;
+    uint32_t psel_a;
+    uint32_t psel_b;
+    uint32_t psel_led;
+    uint32_t sampleper;
+    uint32_t reportper;
+    int32_t accread;
+    uint32_t accdblread;
+} NRF_QDEC_Type;
+
+extern NRF_QDEC_Type nrf_qdec_model;
+
+// soc.h provides this on nRF, the host GPIO emulator has a single port
+#define NRF_DT_GPIOS_TO_PSEL(node_id, prop) DT_GPIO_PIN(node_id, prop)
+
+typedef enum {
+    NRF_QDEC_TASK_START,
+    NRF_QDEC_TASK_STOP,
+} nrf_qdec_task_t;
+
+typedef enum {
+    NRF_QDEC_EVENT_REPORTRDY,
+} nrf_qdec_event_t;
+
+typedef enum {
+    NRF_QDEC_SAMPLEPER_128US,
+    NRF_QDEC_SAMPLEPER_256US,
+    NRF_QDEC_SAMPLEPER_512US,
+    NRF_QDEC_SAMPLEPER_1024US,
+    NRF_QDEC_SAMPLEPER_2048US,
+    NRF_QDEC_SAMPLEPER_4096US,
+    NRF_QDEC_SAMPLEPER_8192US,
+    NRF_QDEC_SAMPLEPER_16384US,
+} nrf_qdec_sampleper_t;
+
+typedef enum {
+    NRF_QDEC_REPORTPER_10,
+    NRF_QDEC_REPORTPER_40,
+    NRF_QDEC_REPORTPER_80,
+    NRF_QDEC_REPORTPER_120,
+    NRF_QDEC_REPORTPER_160,
+    NRF_QDEC_REPORTPER_200,
+    NRF_QDEC_REPORTPER_240,
+    NRF_QDEC_REPORTPER_280,
+} nrf_qdec_reportper_t;
+
+#define NRF_QDEC_LED_NOT_CONNECTED 0xFFFFFFFF
+#define NRF_QDEC_SHORT_REPORTRDY_READCLRACC_MASK BIT(0)
+#define NRF_QDEC_INT_REPORTRDY_MASK BIT(1)
+
+static inline bool nrf_qdec_event_check(NRF_QDEC_Type const *reg, nrf_qdec_event_t event) {
+    return nrf_qdec_model.events_reportrdy;
+}
+
+static inline void nrf_qdec_event_clear(NRF_QDEC_Type *reg, nrf_qdec_event_t event) {
+    nrf_qdec_model.events_reportrdy = false;
+}
+
+static inline int32_t nrf_qdec_accread_get(NRF_QDEC_Type const *reg) {
+    return nrf_qdec_model.accread;
+}
+
+static inline uint32_t nrf_qdec_accdblread_get(NRF_QDEC_Type const *reg) {
+    return nrf_qdec_model.accdblread;
+}
+
+static inline void nrf_qdec_enable(NRF_QDEC_Type *reg) { nrf_qdec_model.enabled = true; }
+
+static inline void nrf_qdec_disable(NRF_QDEC_Type *reg) { nrf_qdec_model.enabled = false; }
+
+static inline void nrf_qdec_task_trigger(NRF_QDEC_Type *reg, nrf_qdec_task_t task) {
+    nrf_qdec_model.started = task == NRF_QDEC_TASK_START;
+}
+
+static inline void nrf_qdec_pins_set(NRF_QDEC_Type *reg, uint32_t psel_a, uint32_t psel_b,
+                                     uint32_t psel_led) {
+    nrf_qdec_model.psel_a = psel_a;
+    nrf_qdec_model.psel_b = psel_b;
+    nrf_qdec_model.psel_led = psel_led;
+}
+
+static inline void nrf_qdec_sampleper_set(NRF_QDEC_Type *reg, nrf_qdec_sampleper_t sampleper) {
+    nrf_qdec_model.sampleper = sampleper;
+}
+
+static inline void nrf_qdec_reportper_set(NRF_QDEC_Type *reg, nrf_qdec_reportper_t reportper) {
+    nrf_qdec_model.reportper = reportper;
+}
+
+static inline void nrf_qdec_dbfen_enable(NRF_QDEC_Type *reg) { nrf_qdec_model.dbfen = true; }
+
+static inline void nrf_qdec_dbfen_disable(NRF_QDEC_Type *reg) { nrf_qdec_model.dbfen = false; }
+
+static inline void nrf_qdec_shorts_enable(NRF_QDEC_Type *reg, uint32_t mask) {
+    nrf_qdec_model.shorts |= mask;
+}
+
+static inline void nrf_qdec_int_enable(NRF_QDEC_Type *reg, uint32_t mask) {
+    nrf_qdec_model.intenset |= mask;
+}
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+// the driver is compiled in here so its ISR and sensor API functions can be called directly
+#include "qdec_encoder.c"
+
+NRF_QDEC_Type nrf_qdec_model;
+
+static const struct device *qdec = DEVICE_DT_GET(DT_NODELABEL(qdec));
+
+// 20 detents per rotation, the keymap's default, and four steps to each
+#define DETENT_DEGREES 18
+#define STEPS_PER_DETENT 4
+
+static int triggers;
+
+static void count_trigger(const struct device *dev, const struct sensor_trigger *trig) {
+    triggers++;
+}
+
+// what the QDEC does once report-samples samples have been taken: the READCLRACC short moves ACC
+// and ACCDBL to their read registers, then REPORTRDY fires its interrupt
+static void report(int32_t acc, uint32_t dbl) {
+    nrf_qdec_model.accread = acc;
+    nrf_qdec_model.accdblread = dbl;
+    nrf_qdec_model.events_reportrdy = true;
+    qdec_isr(qdec);
+}
+
+static struct sensor_value fetch_rotation() {
+    struct sensor_value val;
+
+    zassert_ok(sensor_sample_fetch(qdec));
+    zassert_ok(sensor_channel_get(qdec, SENSOR_CHAN_ROTATION, &val));
+    return val;
+}
+
+// The degree carry of ZMK v0.2.1's sensor rotate behaviors, for one sensor on one layer: what is
+// left below a whole detent is kept for the next event.
+static struct sensor_value carry;
+
+static int carry_detents(struct sensor_value val) {
+    carry.val1 += val.val1;
+    carry.val2 += val.val2;
+    carry.val1 += carry.val2 / 1000000;
+    carry.val2 %= 1000000;
+
+    int detents = carry.val1 / DETENT_DEGREES;
+    carry.val1 %= DETENT_DEGREES;
+    return detents;
+}
+
+// Sends one report per entry, with a double step on every third, and fetches after every lag
+// reports as a system work queue running behind the interrupt would. Returns the detents the
+// sensor behavior raises.
+static int spin(const int32_t *reports, size_t count, int lag) {
+    int detents = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        report(reports[i], i % 3 == 2);
+        if ((i + 1) % lag == 0 || i == count - 1) {
+            detents += carry_detents(fetch_rotation());
+        }
+    }
+
+    return detents;
+}
+
+static void qdec_encoder_before(void *fixture) {
+    struct qdec_data *data = qdec->data;
+
+    data->pending = 0;
+    data->fetched = 0;
+    data->handler = NULL;
+    atomic_clear(&data->steps);
+    atomic_clear(&data->doubles);
+    atomic_clear(&data->reports);
+    nrf_qdec_model.events_reportrdy = false;
+    triggers = 0;
+    carry = (struct sensor_value){0};
+}
+
+ZTEST_SUITE(qdec_encoder, NULL, NULL, qdec_encoder_before, NULL, NULL);
+
+ZTEST(qdec_encoder, test_setup_programs_the_peripheral) {
+    zassert_true(device_is_ready(qdec));
+    zassert_true(nrf_qdec_model.enabled && nrf_qdec_model.started);
+    zassert_equal(nrf_qdec_model.psel_a, 10);
+    zassert_equal(nrf_qdec_model.psel_b, 11);
+    zassert_equal(nrf_qdec_model.psel_led, NRF_QDEC_LED_NOT_CONNECTED);
+    zassert_equal(nrf_qdec_model.sampleper, NRF_QDEC_SAMPLEPER_256US);
+    zassert_equal(nrf_qdec_model.reportper, NRF_QDEC_REPORTPER_40);
+    zassert_true(nrf_qdec_model.dbfen);
+    zassert_true(nrf_qdec_model.shorts & NRF_QDEC_SHORT_REPORTRDY_READCLRACC_MASK);
+    zassert_true(nrf_qdec_model.intenset & NRF_QDEC_INT_REPORTRDY_MASK);
+}
+
+// 80 steps per rotation, so a four step detent is 18 degrees
+ZTEST(qdec_encoder, test_whole_detent) {
+    report(4, 0);
+
+    struct sensor_value val = fetch_rotation();
+    zassert_equal(val.val1, 18);
+    zassert_equal(val.val2, 0);
+
+    report(-4, 0);
+
+    val = fetch_rotation();
+    zassert_equal(val.val1, -18);
+    zassert_equal(val.val2, 0);
+}
+
+// a single step is 4.5 degrees, the half degree is kept in val2 with the sign of val1
+ZTEST(qdec_encoder, test_remainder) {
+    report(1, 0);
+
+    struct sensor_value val = fetch_rotation();
+    zassert_equal(val.val1, 4);
+    zassert_equal(val.val2, 500000);
+
+    report(-3, 0);
+
+    val = fetch_rotation();
+    zassert_equal(val.val1, -13);
+    zassert_equal(val.val2, -500000);
+}
+
+// reports between fetches add up, a fetch takes them all and leaves nothing for the next one
+ZTEST(qdec_encoder, test_pending_accumulates) {
+    struct qdec_data *data = qdec->data;
+
+    report(3, 0);
+    report(5, 0);
+    report(-2, 0);
+    zassert_equal(data->pending, 6);
+
+    struct sensor_value val = fetch_rotation();
+    zassert_equal(val.val1, 27);
+    zassert_equal(val.val2, 0);
+    zassert_equal(data->pending, 0);
+
+    val = fetch_rotation();
+    zassert_equal(val.val1, 0);
+    zassert_equal(val.val2, 0);
+}
+
+// a long spin in one report, 100 steps is a rotation and a quarter
+ZTEST(qdec_encoder, test_more_than_a_rotation) {
+    report(100, 0);
+
+    struct sensor_value val = fetch_rotation();
+    zassert_equal(val.val1, 450);
+    zassert_equal(val.val2, 0);
+}
+
+// Ten rotations at full speed: 800 steps in 37 step reports, with the fetches two reports behind.
+// Every step lands in exactly one detent, there and back.
+ZTEST(qdec_encoder, test_fast_spin) {
+    struct qdec_data *data = qdec->data;
+    int32_t reports[22];
+
+    for (int i = 0; i < 21; i++) {
+        reports[i] = 37;
+    }
+    reports[21] = 800 - 21 * 37;
+
+    zassert_equal(spin(reports, ARRAY_SIZE(reports), 2), 800 / STEPS_PER_DETENT);
+    zassert_equal(carry.val1, 0);
+    zassert_equal(carry.val2, 0);
+
+    for (int i = 0; i < ARRAY_SIZE(reports); i++) {
+        reports[i] = -reports[i];
+    }
+
+    zassert_equal(spin(reports, ARRAY_SIZE(reports), 2), -800 / STEPS_PER_DETENT);
+    zassert_equal(carry.val1, 0);
+    zassert_equal(carry.val2, 0);
+    zassert_equal(atomic_get(&data->steps), 1600);
+    zassert_equal(atomic_get(&data->doubles), 14);
+    zassert_equal(atomic_get(&data->reports), 44);
+}
+
+// Every odd report size from 1 to 39 steps, 400 steps in all, fetched one report at a time and
+// then three at a time. No sub-detent remainder is lost or counted twice along the way.
+ZTEST(qdec_encoder, test_odd_reports) {
+    int32_t reports[20];
+
+    for (int i = 0; i < ARRAY_SIZE(reports); i++) {
+        reports[i] = 2 * i + 1;
+    }
+
+    for (int lag = 1; lag <= 3; lag += 2) {
+        zassert_equal(spin(reports, ARRAY_SIZE(reports), lag), 400 / STEPS_PER_DETENT);
+        zassert_equal(carry.val1, 0);
+        zassert_equal(carry.val2, 0);
+    }
+}
+
+ZTEST(qdec_encoder, test_counts) {
+    struct qdec_data *data = qdec->data;
+
+    report(4, 0);
+    report(-6, 2);
+
+    zassert_equal(atomic_get(&data->steps), 10);
+    zassert_equal(atomic_get(&data->doubles), 2);
+    zassert_equal(atomic_get(&data->reports), 2);
+}
+
+// an interrupt without REPORTRDY set leaves everything alone
+ZTEST(qdec_encoder, test_spurious_interrupt) {
+    struct qdec_data *data = qdec->data;
+
+    nrf_qdec_model.accread = 7;
+    qdec_isr(qdec);
+
+    zassert_equal(data->pending, 0);
+    zassert_equal(atomic_get(&data->reports), 0);
+}
+
+ZTEST(qdec_encoder, test_unsupported_channels) {
+    struct sensor_value val;
+
+    zassert_equal(sensor_sample_fetch_chan(qdec, SENSOR_CHAN_AMBIENT_TEMP), -ENOTSUP);
+    zassert_equal(sensor_channel_get(qdec, SENSOR_CHAN_AMBIENT_TEMP, &val), -ENOTSUP);
+}
+
+// the interrupt hands the data ready handler to the system work queue
+ZTEST(qdec_encoder, test_trigger) {
+    static const struct sensor_trigger trig = {
+        .type = SENSOR_TRIG_DATA_READY,
+        .chan = SENSOR_CHAN_ROTATION,
+    };
+    static const struct sensor_trigger other = {
+        .type = SENSOR_TRIG_DELTA,
+        .chan = SENSOR_CHAN_ROTATION,
+    };
+
+    zassert_equal(sensor_trigger_set(qdec, &other, count_trigger), -ENOTSUP);
+    zassert_ok(sensor_trigger_set(qdec, &trig, count_trigger));
+
+    report(4, 0);
+    k_sleep(K_MSEC(1));
+    zassert_equal(triggers, 1);
+
+    struct sensor_value val = fetch_rotation();
+    zassert_equal(val.val1, 18);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include <drivers/behavior.h>
+#include <zmk/behavior_queue.h>
+#include <zmk/virtual_key_position.h>
+
+// Turns the encoder against vol_accel as the keymap binds it, and against ZMK's &inc_dec_kp for a
+// baseline, and counts the volume steps that would reach the behavior queue, each a press and a
+// release report.
+
+#define TRIGGERS_PER_ROTATION 20
+#define STEP_INTERVAL_MS 15 // the binding's default
+
+// long enough for any queue left behind by a spin to run out
+#define DRAIN_MS 10000
+
+static const struct zmk_sensor_config sensor_config = {
+    .triggers_per_rotation = TRIGGERS_PER_ROTATION,
+};
+
+static struct recording {
+    uint32_t presses;
+    uint32_t releases;
+    uint32_t presses_after_stop; // once the knob stopped turning
+    int64_t stopped_ms;
+    int64_t last_press_ms;
+    int64_t min_gap_ms;
+} rec;
+
+int zmk_behavior_queue_add(const struct zmk_behavior_binding_event *event,
+                           const struct zmk_behavior_binding binding, bool press, uint32_t wait) {
+    if (!press) {
+        rec.releases++;
+        return 0;
+    }
+
+    if (rec.presses > 0) {
+        rec.min_gap_ms = MIN(rec.min_gap_ms, event->timestamp - rec.last_press_ms);
+    }
+    rec.presses++;
+    rec.last_press_ms = event->timestamp;
+    if (event->timestamp > rec.stopped_ms) {
+        rec.presses_after_stop++;
+    }
+    return 0;
+}
+
+// one detent of an encoder reporting degrees, as the QDEC and ec11 with steps do
+static void detent(const char *behavior, int direction) {
+    struct zmk_behavior_binding binding = {.behavior_dev = behavior, .param1 = 1, .param2 = 2};
+    struct zmk_behavior_binding_event event = {
+        .layer = 0,
+        .position = ZMK_VIRTUAL_KEY_POSITION_SENSOR(0),
+        .timestamp = k_uptime_get(),
+    };
+    struct zmk_sensor_channel_data data = {
+        .value = {.val1 = direction * 360 / TRIGGERS_PER_ROTATION},
+        .channel = SENSOR_CHAN_ROTATION,
+    };
+
+    zassert_ok(behavior_sensor_keymap_binding_accept_data(&binding, event, &sensor_config, 1,
+                                                          &data));
+    behavior_sensor_keymap_binding_process(&binding, event,
+                                           BEHAVIOR_SENSOR_BINDING_PROCESS_MODE_TRIGGER);
+}
+
+// turns at a steady rate, then lets the steps run out
+static void turn(const char *behavior, uint32_t detents, uint32_t detent_ms) {
+    rec = (struct recording){.stopped_ms = INT64_MAX, .min_gap_ms = INT64_MAX};
+
+    for (int i = 0; i < detents; i++) {
+        detent(behavior, 1);
+        k_sleep(K_MSEC(detent_ms));
+    }
+    rec.stopped_ms = k_uptime_get();
+    k_sleep(K_MSEC(DRAIN_MS));
+
+    zassert_equal(rec.presses, rec.releases);
+}
+
+ZTEST_SUITE(sensor_accel, NULL, NULL, NULL, NULL, NULL);
+
+// one rotation at a detent every 200 ms stays at one step per detent
+ZTEST(sensor_accel, test_slow_turn) {
+    turn("vol_accel", TRIGGERS_PER_ROTATION, 200);
+
+    zassert_equal(rec.presses, TRIGGERS_PER_ROTATION);
+    zassert_equal(rec.presses_after_stop, 0);
+}
+
+// Two seconds at four rotations a second. The curve is bounded by the 66 steps a second the
+// pacing sends, so nothing waits to reach max-pending: the capped run sends every step the
+// uncapped one does, and the output stops with the knob.
+ZTEST(sensor_accel, test_fast_spin) {
+    uint32_t uncapped;
+
+    turn("vol_accel_uncapped", 4 * TRIGGERS_PER_ROTATION * 2, 1000 / (4 * TRIGGERS_PER_ROTATION));
+    uncapped = rec.presses;
+    zassert_true(rec.presses_after_stop <= 1, "uncapped: %u steps after the knob stopped",
+                 rec.presses_after_stop);
+
+    turn("vol_accel", 4 * TRIGGERS_PER_ROTATION * 2, 1000 / (4 * TRIGGERS_PER_ROTATION));
+
+    printk("fast spin: uncapped %u steps, capped %u steps, %u after the knob stopped\n", uncapped,
+           rec.presses, rec.presses_after_stop);
+
+    zassert_equal(rec.presses, uncapped, "max-pending dropped %d steps",
+                  (int)(uncapped - rec.presses));
+    zassert_true(rec.presses_after_stop <= 1, "%u steps after the knob stopped",
+                 rec.presses_after_stop);
+    zassert_true(rec.min_gap_ms >= STEP_INTERVAL_MS, "steps %lld ms apart",
+                 (long long)rec.min_gap_ms);
+}
+
+// One rotation at two rotations a second. &inc_dec_kp queues a press and a release for every
+// detent at once, 40 reports. vol_accel sends more steps for the same spin, paced, and drops none.
+ZTEST(sensor_accel, test_spin_against_rotate) {
+    uint32_t rotate_reports, uncapped_reports, accel_reports;
+
+    turn("inc_dec_kp", TRIGGERS_PER_ROTATION, 1000 / (2 * TRIGGERS_PER_ROTATION));
+    rotate_reports = rec.presses + rec.releases;
+    zassert_equal(rotate_reports, 2 * TRIGGERS_PER_ROTATION);
+    zassert_equal(rec.presses_after_stop, 0);
+
+    turn("vol_accel_uncapped", TRIGGERS_PER_ROTATION, 1000 / (2 * TRIGGERS_PER_ROTATION));
+    uncapped_reports = rec.presses + rec.releases;
+
+    turn("vol_accel", TRIGGERS_PER_ROTATION, 1000 / (2 * TRIGGERS_PER_ROTATION));
+    accel_reports = rec.presses + rec.releases;
+
+    printk("%u detent spin: inc_dec_kp %u reports, vol_accel %u reports, %u steps after the knob "
+           "stopped\n",
+           TRIGGERS_PER_ROTATION, rotate_reports, accel_reports, rec.presses_after_stop);
+
+    zassert_equal(accel_reports, uncapped_reports, "max-pending dropped steps");
+    zassert_true(accel_reports > rotate_reports, "%u reports", accel_reports);
+    zassert_true(rec.presses_after_stop <= 1, "%u steps after the knob stopped",
+                 rec.presses_after_stop);
+    zassert_true(rec.min_gap_ms >= STEP_INTERVAL_MS, "steps %lld ms apart",
+                 (long long)rec.min_gap_ms);
+}
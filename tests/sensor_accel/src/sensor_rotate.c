@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT zmk_behavior_sensor_rotate_var
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <drivers/behavior.h>
+#include <stdlib.h>
+
+#include <zmk/behavior.h>
+#include <zmk/behavior_queue.h>
+#include <zmk/keymap.h>
+#include <zmk/sensors.h>
+#include <zmk/virtual_key_position.h>
+
+// ZMK v0.2.1's zmk,behavior-sensor-rotate-var as &inc_dec_kp binds it: the same degree carry,
+// then a press and a release queued for every detent at once, however fast the knob turns.
+
+struct rotate_config {
+    const char *cw_dev;
+    const char *ccw_dev;
+    uint32_t tap_ms;
+};
+
+struct rotate_data {
+    struct sensor_value remainder[ZMK_KEYMAP_SENSORS_LEN][ZMK_KEYMAP_LAYERS_LEN];
+    int triggers[ZMK_KEYMAP_SENSORS_LEN][ZMK_KEYMAP_LAYERS_LEN];
+};
+
+static int rotate_accept_data(struct zmk_behavior_binding *binding,
+                              struct zmk_behavior_binding_event event,
+                              const struct zmk_sensor_config *sensor_config,
+                              size_t channel_data_size,
+                              const struct zmk_sensor_channel_data *channel_data) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    struct rotate_data *data = dev->data;
+    int sensor_index = ZMK_SENSOR_POSITION_FROM_VIRTUAL_KEY_POSITION(event.position);
+    struct sensor_value *remainder = &data->remainder[sensor_index][event.layer];
+    int trigger_degrees = 360 / sensor_config->triggers_per_rotation;
+
+    remainder->val1 += channel_data[0].value.val1;
+    remainder->val2 += channel_data[0].value.val2;
+    if (remainder->val2 >= 1000000 || remainder->val2 <= -1000000) {
+        remainder->val1 += remainder->val2 / 1000000;
+        remainder->val2 %= 1000000;
+    }
+
+    data->triggers[sensor_index][event.layer] = remainder->val1 / trigger_degrees;
+    remainder->val1 %= trigger_degrees;
+    return 0;
+}
+
+static int rotate_process(struct zmk_behavior_binding *binding,
+                          struct zmk_behavior_binding_event event,
+                          enum behavior_sensor_binding_process_mode mode) {
+    const struct device *dev = zmk_behavior_get_binding(binding->behavior_dev);
+    const struct rotate_config *cfg = dev->config;
+    struct rotate_data *data = dev->data;
+    int sensor_index = ZMK_SENSOR_POSITION_FROM_VIRTUAL_KEY_POSITION(event.position);
+    int triggers = data->triggers[sensor_index][event.layer];
+
+    data->triggers[sensor_index][event.layer] = 0;
+    if (mode != BEHAVIOR_SENSOR_BINDING_PROCESS_MODE_TRIGGER || triggers == 0) {
+        return ZMK_BEHAVIOR_TRANSPARENT;
+    }
+
+    struct zmk_behavior_binding triggered = {
+        .behavior_dev = triggers > 0 ? cfg->cw_dev : cfg->ccw_dev,
+        .param1 = triggers > 0 ? binding->param1 : binding->param2,
+    };
+
+    for (int i = 0; i < abs(triggers); i++) {
+        zmk_behavior_queue_add(&event, triggered, true, cfg->tap_ms);
+        zmk_behavior_queue_add(&event, triggered, false, 0);
+    }
+
+    return ZMK_BEHAVIOR_OPAQUE;
+}
+
+static const struct behavior_driver_api rotate_api = {
+    .sensor_binding_accept_data = rotate_accept_data,
+    .sensor_binding_process = rotate_process,
+};
+
+#define SENSOR_ROTATE_INST(n)                                                                      \
+    static const struct rotate_config rotate_config_##n = {                                        \
+        .cw_dev = DEVICE_DT_NAME(DT_INST_PHANDLE_BY_IDX(n, bindings, 0)),                          \
+        .ccw_dev = DEVICE_DT_NAME(DT_INST_PHANDLE_BY_IDX(n, bindings, 1)),                         \
+        .tap_ms = DT_INST_PROP(n, tap_ms),                                                         \
+    };                                                                                             \
+                                                                                                   \
+    static struct rotate_data rotate_data_##n;                                                     \
+                                                                                                   \
+    BEHAVIOR_DT_INST_DEFINE(n, NULL, NULL, &rotate_data_##n, &rotate_config_##n, POST_KERNEL,      \
+                            CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &rotate_api);
+
+DT_INST_FOREACH_STATUS_OKAY(SENSOR_ROTATE_INST)
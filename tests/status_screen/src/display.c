@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+
+#include <lvgl.h>
+
+#include <zmk/display.h>
+
+#include "custom_status_screen.h"
+
+// ZMK's display main as v0.2.1 runs it: the screen is built on the display work queue, and a 10 ms
+// timer submits the LVGL task handler there for as long as the display is not blanked.
+
+#define TICK_MS 10
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+static bool initialized;
+
+#if IS_ENABLED(CONFIG_ZMK_DISPLAY_WORK_QUEUE_DEDICATED)
+K_THREAD_STACK_DEFINE(display_work_stack_area, CONFIG_ZMK_DISPLAY_DEDICATED_THREAD_STACK_SIZE);
+static struct k_work_q display_work_q;
+#endif
+
+struct k_work_q *zmk_display_work_q() {
+#if IS_ENABLED(CONFIG_ZMK_DISPLAY_WORK_QUEUE_DEDICATED)
+    return &display_work_q;
+#else
+    return &k_sys_work_q;
+#endif
+}
+
+bool zmk_display_is_initialized() { return initialized; }
+
+static void display_tick_cb(struct k_work *work) { lv_task_handler(); }
+
+static K_WORK_DEFINE(display_tick_work, display_tick_cb);
+
+static void display_timer_cb(struct k_timer *timer) {
+    k_work_submit_to_queue(zmk_display_work_q(), &display_tick_work);
+}
+
+static K_TIMER_DEFINE(display_timer, display_timer_cb, NULL);
+
+static void initialize_display(struct k_work *work) {
+    lv_scr_load(zmk_display_status_screen());
+    initialized = true;
+
+    display_blanking_off(display);
+    k_timer_start(&display_timer, K_MSEC(TICK_MS), K_MSEC(TICK_MS));
+}
+
+static K_WORK_DEFINE(init_work, initialize_display);
+
+int zmk_display_init() {
+    if (!device_is_ready(display)) {
+        return -ENODEV;
+    }
+
+#if IS_ENABLED(CONFIG_ZMK_DISPLAY_WORK_QUEUE_DEDICATED)
+    k_work_queue_start(&display_work_q, display_work_stack_area,
+                       K_THREAD_STACK_SIZEOF(display_work_stack_area),
+                       CONFIG_ZMK_DISPLAY_DEDICATED_THREAD_PRIORITY, NULL);
+#endif
+
+    k_work_submit_to_queue(zmk_display_work_q(), &init_work);
+    return 0;
+}
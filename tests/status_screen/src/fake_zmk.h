@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+#include <zmk/endpoints.h>
+#include <zmk/hid_indicators.h>
+
+#include "battery_gauge.h"
+
+// What ZMK's getters return. The traces change a field and raise the event ZMK raises for it.
+struct fake_zmk_state {
+    struct zmk_endpoint_instance endpoint;
+    int profile_index;
+    bool profile_connected;
+    bool profile_open;
+    bool usb_hid_ready;
+    uint8_t highest_layer;
+    uint8_t explicit_mods;
+    zmk_hid_indicators_t indicators;
+    int wpm;
+    struct zmk_battery_gauge_state gauge;
+};
+
+extern struct fake_zmk_state fake_zmk;
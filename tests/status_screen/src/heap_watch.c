@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include "heap_watch.h"
+
+// LVGL allocates through lvgl_malloc, lvgl_realloc and lvgl_free. They are linked with --wrap, so
+// every block here carries its requested size ahead of it. LVGL only runs on the display work
+// queue, the counts need no lock.
+
+struct block {
+    size_t size;
+} __aligned(8);
+
+void *__real_lvgl_malloc(size_t size);
+void *__real_lvgl_realloc(void *ptr, size_t size);
+void __real_lvgl_free(void *ptr);
+
+static size_t in_use;
+static size_t peak;
+
+static void *track(struct block *block, size_t size) {
+    if (block == NULL) {
+        return NULL;
+    }
+
+    block->size = size;
+    in_use += size;
+    peak = MAX(peak, in_use);
+    return block + 1;
+}
+
+void *__wrap_lvgl_malloc(size_t size) {
+    return track(__real_lvgl_malloc(sizeof(struct block) + size), size);
+}
+
+void *__wrap_lvgl_realloc(void *ptr, size_t size) {
+    if (ptr == NULL) {
+        return __wrap_lvgl_malloc(size);
+    }
+
+    struct block *old = (struct block *)ptr - 1;
+    size_t old_size = old->size;
+    struct block *block = __real_lvgl_realloc(old, sizeof(struct block) + size);
+
+    // a failed realloc leaves the old block in place
+    if (block == NULL) {
+        return NULL;
+    }
+
+    in_use -= old_size;
+    return track(block, size);
+}
+
+void __wrap_lvgl_free(void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+
+    struct block *block = (struct block *)ptr - 1;
+
+    in_use -= block->size;
+    __real_lvgl_free(block);
+}
+
+size_t heap_watch_in_use() { return in_use; }
+
+size_t heap_watch_peak() { return peak; }
+
+void heap_watch_reset_peak() { peak = in_use; }
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+// LVGL heap bytes in use, as requested, and their peak since the last reset.
+size_t heap_watch_in_use();
+size_t heap_watch_peak();
+
+// Starts a new peak from what is in use now.
+void heap_watch_reset_peak();
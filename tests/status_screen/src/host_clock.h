@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// CPU time the host process has used, in nanoseconds. Simulated time stands still while code
+// runs, so this is what a render costs.
+uint64_t arixa_host_cpu_ns();
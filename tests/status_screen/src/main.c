@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/ztest.h>
+
+#include <dt-bindings/zmk/modifiers.h>
+#include <zmk/display.h>
+#include <zmk/endpoints.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#include <zmk/events/endpoint_changed.h>
+#include <zmk/events/layer_state_changed.h>
+#include <zmk/events/position_state_changed.h>
+#include <zmk/events/wpm_state_changed.h>
+
+#include "events/battery_gauge_changed.h"
+#include "events/explicit_mods_changed.h"
+#include "render_profile.h"
+
+#include "fake_zmk.h"
+#include "heap_watch.h"
+#include "host_clock.h"
+#include "mem_display.h"
+
+// Each test replays one scripted trace of ZMK events against the status screen, advancing
+// simulated time in display ticks, then reports what rendering it cost:
+//
+//   render      host CPU time for the whole trace and the most any one tick took, nearly all of
+//               it widget updates, LVGL refreshes and flushes on the display work queue
+//   invalidated pixels LVGL redrew, or the compositor wrote, from ARIXA_RENDER_PROFILE
+//   flushed     bytes and writes that reached the panel
+//   heap        LVGL heap bytes in use at the peak, from boot on and within the trace
+//
+// Host CPU time depends on the machine, compare it between builds on one box. The others are
+// deterministic for a given build and trace.
+
+#define TICK_MS 10
+
+// long enough for the bongo cat rest frame, the output status slides and the last refresh
+#define SETTLE_MS 1000
+
+// with nothing changing, the screen must not be redrawn for this long
+#define IDLE_CHECK_MS 2000
+
+enum step_kind {
+    KEY_PRESS,
+    KEY_RELEASE,
+    WPM,
+    MODS,
+    PROFILE,
+    CONNECTED,
+    ENDPOINT,
+    BATTERY,
+    CHARGING,
+    LAYER,
+};
+
+struct step {
+    uint32_t at_ms; // from the start of the trace
+    enum step_kind kind;
+    int value;
+};
+
+struct trace_result {
+    uint32_t ticks;
+    uint64_t render_ns;
+    uint64_t max_tick_ns;
+    uint64_t invalidated;
+    uint32_t flushed_bytes;
+    uint32_t flushed_writes;
+    size_t heap_peak;
+};
+
+static const struct device *display = DEVICE_DT_GET(DT_CHOSEN(zephyr_display));
+
+static struct step steps[256];
+static size_t step_count;
+static size_t boot_heap_peak;
+
+static void at(uint32_t at_ms, enum step_kind kind, int value) {
+    zassert_true(step_count < ARRAY_SIZE(steps), "trace too long");
+    zassert_true(step_count == 0 || steps[step_count - 1].at_ms <= at_ms, "steps out of order");
+
+    steps[step_count++] = (struct step){.at_ms = at_ms, .kind = kind, .value = value};
+}
+
+static void raise_gauge() {
+    raise_zmk_battery_gauge_changed((struct zmk_battery_gauge_changed){.state = fake_zmk.gauge});
+}
+
+static void apply(const struct step *step) {
+    int64_t now = k_uptime_get();
+
+    switch (step->kind) {
+    case KEY_PRESS:
+    case KEY_RELEASE:
+        raise_zmk_position_state_changed((struct zmk_position_state_changed){
+            .position = step->value, .state = step->kind == KEY_PRESS, .timestamp = now});
+        break;
+    case WPM:
+        fake_zmk.wpm = step->value;
+        raise_zmk_wpm_state_changed((struct zmk_wpm_state_changed){.state = step->value});
+        break;
+    case MODS:
+        fake_zmk.explicit_mods = step->value;
+        raise_zmk_explicit_mods_changed(
+            (struct zmk_explicit_mods_changed){.modifiers = step->value, .timestamp = now});
+        break;
+    case PROFILE:
+        fake_zmk.profile_index = step->value;
+        fake_zmk.endpoint.ble.profile_index = step->value;
+        raise_zmk_ble_active_profile_changed(
+            (struct zmk_ble_active_profile_changed){.index = step->value});
+        break;
+    case CONNECTED:
+        // ZMK raises the profile change again when the active profile connects or drops
+        fake_zmk.profile_connected = step->value;
+        raise_zmk_ble_active_profile_changed(
+            (struct zmk_ble_active_profile_changed){.index = fake_zmk.profile_index});
+        break;
+    case ENDPOINT:
+        fake_zmk.endpoint.transport = step->value;
+        fake_zmk.usb_hid_ready = step->value == ZMK_TRANSPORT_USB;
+        raise_zmk_endpoint_changed((struct zmk_endpoint_changed){.endpoint = fake_zmk.endpoint});
+        break;
+    case BATTERY:
+        fake_zmk.gauge.state_of_charge = step->value;
+        fake_zmk.gauge.millivolts = 3300 + step->value * 9;
+        fake_zmk.gauge.minutes_to_empty = fake_zmk.gauge.charging ? 0 : step->value * 8;
+        raise_gauge();
+        break;
+    case CHARGING:
+        fake_zmk.gauge.charging = step->value;
+        fake_zmk.gauge.minutes_to_empty =
+            fake_zmk.gauge.charging ? 0 : fake_zmk.gauge.state_of_charge * 8;
+        raise_gauge();
+        break;
+    case LAYER:
+        fake_zmk.highest_layer = step->value;
+        raise_zmk_layer_state_changed((struct zmk_layer_state_changed){
+            .layer = step->value, .state = true, .timestamp = now});
+        break;
+    }
+}
+
+// Runs the display until simulated time reaches until, one tick at a time.
+static void run_until(int64_t until, struct trace_result *result) {
+    while (k_uptime_get() < until) {
+        uint64_t start = arixa_host_cpu_ns();
+
+        k_sleep(K_MSEC(TICK_MS));
+
+        uint64_t spent = arixa_host_cpu_ns() - start;
+
+        result->ticks++;
+        result->render_ns += spent;
+        result->max_tick_ns = MAX(result->max_tick_ns, spent);
+    }
+}
+
+static void replay(const char *name) {
+    struct trace_result result = {0};
+    struct zmk_render_profile_stats area;
+    struct mem_display_stats panel;
+    int64_t start;
+
+    zassert_true(step_count > 0, "empty trace");
+
+    zmk_render_profile_reset();
+    mem_display_reset_counts(display);
+    heap_watch_reset_peak();
+    start = k_uptime_get();
+
+    for (size_t i = 0; i < step_count; i++) {
+        run_until(start + steps[i].at_ms, &result);
+
+        uint64_t raised = arixa_host_cpu_ns();
+
+        apply(&steps[i]);
+        result.render_ns += arixa_host_cpu_ns() - raised;
+    }
+    run_until(start + steps[step_count - 1].at_ms + SETTLE_MS, &result);
+
+    zmk_render_profile_get(IS_ENABLED(CONFIG_ARIXA_STATUS_SCREEN_FRAMEBUFFER)
+                               ? RENDER_PROFILE_FLUSH
+                               : RENDER_PROFILE_REFRESH,
+                           &area);
+    mem_display_get_stats(display, &panel);
+    result.invalidated = area.total_area;
+    result.flushed_bytes = panel.bytes;
+    result.flushed_writes = panel.writes;
+    result.heap_peak = heap_watch_peak();
+
+    printk("trace %-10s %4u ticks, render %7u us (max %5u us/tick), invalidated %7u px, "
+           "flushed %6u B in %4u writes, LVGL heap peak %5u B (boot %5u B)\n",
+           name, result.ticks, (uint32_t)(result.render_ns / 1000),
+           (uint32_t)(result.max_tick_ns / 1000), (uint32_t)result.invalidated,
+           result.flushed_bytes, result.flushed_writes, (uint32_t)result.heap_peak,
+           (uint32_t)boot_heap_peak);
+
+    zassert_true(result.flushed_bytes > 0, "%s: the screen never changed", name);
+    zassert_true(result.heap_peak <= CONFIG_LV_Z_MEM_POOL_SIZE, "%s: LVGL heap overflow", name);
+
+    // no animation or refresh may keep running once the trace is over
+    mem_display_reset_counts(display);
+    run_until(k_uptime_get() + IDLE_CHECK_MS, &result);
+    mem_display_get_stats(display, &panel);
+    zassert_equal(panel.bytes, 0, "%s: %u B flushed while idle", name, panel.bytes);
+}
+
+static void *status_screen_setup() {
+    zassert_ok(zmk_display_init());
+    k_sleep(K_MSEC(SETTLE_MS));
+    zassert_true(zmk_display_is_initialized());
+
+    boot_heap_peak = heap_watch_peak();
+    return NULL;
+}
+
+static void status_screen_before(void *fixture) { step_count = 0; }
+
+ZTEST_SUITE(status_screen, NULL, status_screen_setup, status_screen_before, NULL, NULL);
+
+// 80 WPM on the number keys, with the WPM events ZMK raises once a second
+ZTEST(status_screen, test_wpm) {
+    for (int i = 0; i < 60; i++) {
+        at(i * 150, KEY_PRESS, 3 + i % 6);
+        at(i * 150 + 60, KEY_RELEASE, 3 + i % 6);
+        if (i % 7 == 6) {
+            at(i * 150 + 90, WPM, MIN(20 * (i / 7 + 1), 80));
+        }
+    }
+    at(60 * 150 + 1000, WPM, 0);
+
+    replay("wpm");
+}
+
+// every modifier tapped alone, then held in the chords a shortcut uses
+ZTEST(status_screen, test_modifiers) {
+    static const uint8_t chords[] = {
+        MOD_LSFT | MOD_LCTL,
+        MOD_LCTL | MOD_LALT,
+        MOD_LGUI | MOD_LSFT,
+        MOD_LCTL | MOD_LALT | MOD_LSFT | MOD_LGUI,
+    };
+    uint32_t t = 0;
+
+    for (int i = 0; i < 8; i++, t += 300) {
+        at(t, MODS, BIT(i));
+        at(t + 120, MODS, 0);
+    }
+    for (int i = 0; i < ARRAY_SIZE(chords); i++, t += 400) {
+        at(t, MODS, chords[i] & (MOD_LSFT | MOD_LCTL));
+        at(t + 40, MODS, chords[i]);
+        at(t + 200, MODS, 0);
+    }
+
+    replay("modifiers");
+}
+
+// through all five profiles, each dropping and reconnecting, then over to USB and back
+ZTEST(status_screen, test_ble_profiles) {
+    uint32_t t = 0;
+
+    for (int profile = 1; profile <= 5; profile++, t += 600) {
+        at(t, CONNECTED, false);
+        at(t + 50, PROFILE, profile % 5);
+        at(t + 300, CONNECTED, true);
+    }
+    at(t, ENDPOINT, ZMK_TRANSPORT_USB);
+    at(t + 800, ENDPOINT, ZMK_TRANSPORT_BLE);
+
+    replay("ble");
+}
+
+// a full discharge in 5 % steps, then on and off the charger
+ZTEST(status_screen, test_battery) {
+    uint32_t t = 0;
+
+    for (int soc = 100; soc >= 5; soc -= 5, t += 200) {
+        at(t, BATTERY, soc);
+    }
+    at(t, CHARGING, true);
+    at(t + 300, BATTERY, 10);
+    at(t + 600, CHARGING, false);
+
+    replay("battery");
+}
+
+// layer taps through every layer and back, three times over
+ZTEST(status_screen, test_layers) {
+    uint32_t t = 0;
+
+    for (int round = 0; round < 3; round++) {
+        for (int layer = 1; layer <= 4; layer++, t += 250) {
+            at(t, LAYER, layer % 4);
+        }
+    }
+
+    replay("layers");
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT arixa_mem_display
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/display.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <string.h>
+
+#include "mem_display.h"
+
+// Reports itself as the SSD1306 driver does, mono with 8 row vertical byte pages, so LVGL and the
+// shadow flush take the same paths they take on the pad.
+
+#define MAX_WIDTH 128
+#define MAX_PAGES 8
+
+#define SSD1306_CONTROL_COMMAND 0x00
+#define SSD1306_SET_CONTRAST 0x81
+#define SSD1306_CHARGE_PUMP 0x8D
+
+struct mem_display_config {
+    uint16_t width;
+    uint16_t height;
+    bool inversion_on;
+};
+
+struct mem_display_data {
+    uint8_t gddram[MAX_PAGES][MAX_WIDTH];
+    struct mem_display_stats stats;
+};
+
+static int mem_display_blanking_on(const struct device *dev) {
+    struct mem_display_data *data = dev->data;
+
+    data->stats.blanked = true;
+    return 0;
+}
+
+static int mem_display_blanking_off(const struct device *dev) {
+    struct mem_display_data *data = dev->data;
+
+    data->stats.blanked = false;
+    return 0;
+}
+
+static int mem_display_write(const struct device *dev, const uint16_t x, const uint16_t y,
+                             const struct display_buffer_descriptor *desc, const void *buf) {
+    const struct mem_display_config *cfg = dev->config;
+    struct mem_display_data *data = dev->data;
+    const uint8_t *src = buf;
+
+    if (y % 8 != 0 || desc->height % 8 != 0 || x + desc->width > cfg->width ||
+        y + desc->height > cfg->height) {
+        return -EINVAL;
+    }
+
+    for (int page = 0; page < desc->height / 8; page++) {
+        memcpy(&data->gddram[y / 8 + page][x], &src[page * desc->pitch], desc->width);
+    }
+
+    data->stats.writes++;
+    data->stats.bytes += desc->width * desc->height / 8;
+    return 0;
+}
+
+static int mem_display_read(const struct device *dev, const uint16_t x, const uint16_t y,
+                            const struct display_buffer_descriptor *desc, void *buf) {
+    return -ENOTSUP;
+}
+
+static void *mem_display_get_framebuffer(const struct device *dev) { return NULL; }
+
+static int mem_display_set_brightness(const struct device *dev, const uint8_t brightness) {
+    return -ENOTSUP;
+}
+
+static int mem_display_set_contrast(const struct device *dev, const uint8_t contrast) {
+    struct mem_display_data *data = dev->data;
+
+    data->stats.contrast = contrast;
+    return 0;
+}
+
+static void mem_display_get_capabilities(const struct device *dev,
+                                         struct display_capabilities *caps) {
+    const struct mem_display_config *cfg = dev->config;
+
+    memset(caps, 0, sizeof(*caps));
+    caps->x_resolution = cfg->width;
+    caps->y_resolution = cfg->height;
+    caps->supported_pixel_formats = PIXEL_FORMAT_MONO10;
+    caps->current_pixel_format = PIXEL_FORMAT_MONO10;
+    caps->screen_info = SCREEN_INFO_MONO_VTILED;
+}
+
+static int mem_display_set_pixel_format(const struct device *dev,
+                                        const enum display_pixel_format pixel_format) {
+    return pixel_format == PIXEL_FORMAT_MONO10 ? 0 : -ENOTSUP;
+}
+
+static int mem_display_set_orientation(const struct device *dev,
+                                       const enum display_orientation orientation) {
+    return -ENOTSUP;
+}
+
+static const struct display_driver_api mem_display_api = {
+    .blanking_on = mem_display_blanking_on,
+    .blanking_off = mem_display_blanking_off,
+    .write = mem_display_write,
+    .read = mem_display_read,
+    .get_framebuffer = mem_display_get_framebuffer,
+    .set_brightness = mem_display_set_brightness,
+    .set_contrast = mem_display_set_contrast,
+    .get_capabilities = mem_display_get_capabilities,
+    .set_pixel_format = mem_display_set_pixel_format,
+    .set_orientation = mem_display_set_orientation,
+};
+
+// Commands come as a control byte and the command bytes after it, only the ones the OLED theme
+// sends change the panel state here.
+static void run_commands(struct mem_display_data *data, const uint8_t *cmd, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        data->stats.commands++;
+
+        switch (cmd[i]) {
+        case 0xA6:
+        case 0xA7:
+            data->stats.reversed = cmd[i] == 0xA7;
+            break;
+        case 0xAE:
+        case 0xAF:
+            data->stats.display_on = cmd[i] == 0xAF;
+            break;
+        case SSD1306_SET_CONTRAST:
+            if (i + 1 < len) {
+                data->stats.contrast = cmd[++i];
+                data->stats.commands++;
+            }
+            break;
+        case SSD1306_CHARGE_PUMP:
+            if (i + 1 < len) {
+                data->stats.charge_pump_on = cmd[++i] == 0x14;
+                data->stats.commands++;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static int mem_display_emul_transfer(const struct emul *target, struct i2c_msg *msgs,
+                                     int num_msgs, int addr) {
+    struct mem_display_data *data = target->data;
+
+    for (int i = 0; i < num_msgs; i++) {
+        if ((msgs[i].flags & I2C_MSG_RW_MASK) != I2C_MSG_WRITE || msgs[i].len == 0) {
+            return -EIO;
+        }
+        if (msgs[i].buf[0] == SSD1306_CONTROL_COMMAND) {
+            run_commands(data, &msgs[i].buf[1], msgs[i].len - 1);
+        }
+    }
+
+    return 0;
+}
+
+static const struct i2c_emul_api mem_display_emul_api = {
+    .transfer = mem_display_emul_transfer,
+};
+
+static int mem_display_emul_init(const struct emul *target, const struct device *parent) {
+    return 0;
+}
+
+void mem_display_get_stats(const struct device *dev, struct mem_display_stats *out) {
+    struct mem_display_data *data = dev->data;
+
+    *out = data->stats;
+}
+
+void mem_display_reset_counts(const struct device *dev) {
+    struct mem_display_data *data = dev->data;
+
+    data->stats.writes = 0;
+    data->stats.bytes = 0;
+    data->stats.commands = 0;
+}
+
+uint32_t mem_display_set_pixels(const struct device *dev) {
+    struct mem_display_data *data = dev->data;
+    uint32_t set = 0;
+
+    for (int page = 0; page < MAX_PAGES; page++) {
+        for (int x = 0; x < MAX_WIDTH; x++) {
+            set += POPCOUNT(data->gddram[page][x]);
+        }
+    }
+
+    return set;
+}
+
+static int mem_display_init(const struct device *dev) {
+    const struct mem_display_config *cfg = dev->config;
+    struct mem_display_data *data = dev->data;
+
+    // what the SSD1306 driver programs at boot
+    data->stats.blanked = true;
+    data->stats.display_on = true;
+    data->stats.charge_pump_on = true;
+    data->stats.reversed = cfg->inversion_on;
+    data->stats.contrast = CONFIG_SSD1306_DEFAULT_CONTRAST;
+    return 0;
+}
+
+#define MEM_DISPLAY_INST(n)                                                                        \
+    BUILD_ASSERT(DT_INST_PROP(n, width) <= MAX_WIDTH && DT_INST_PROP(n, height) <= MAX_PAGES * 8,  \
+                 "the panel memory is sized for 128x64");                                          \
+                                                                                                   \
+    static struct mem_display_data mem_display_data_##n;                                           \
+                                                                                                   \
+    static const struct mem_display_config mem_display_config_##n = {                              \
+        .width = DT_INST_PROP(n, width),                                                           \
+        .height = DT_INST_PROP(n, height),                                                         \
+        .inversion_on = DT_INST_PROP(n, inversion_on),                                             \
+    };                                                                                             \
+                                                                                                   \
+    DEVICE_DT_INST_DEFINE(n, mem_display_init, NULL, &mem_display_data_##n,                        \
+                          &mem_display_config_##n, POST_KERNEL, CONFIG_DISPLAY_INIT_PRIORITY,      \
+                          &mem_display_api);                                                       \
+                                                                                                   \
+    EMUL_DT_INST_DEFINE(n, mem_display_emul_init, &mem_display_data_##n, NULL,                     \
+                        &mem_display_emul_api, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(MEM_DISPLAY_INST)
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/device.h>
+
+struct mem_display_stats {
+    uint32_t writes;   // display_write calls
+    uint32_t bytes;    // pixel bytes they carried, one byte is 8 rows of a column
+    uint32_t commands; // SSD1306 command bytes received over I2C
+    uint8_t contrast;
+    bool blanked;
+    bool reversed;
+    bool display_on;
+    bool charge_pump_on;
+};
+
+void mem_display_get_stats(const struct device *dev, struct mem_display_stats *out);
+
+// Clears the write, byte and command counts, the panel state stays.
+void mem_display_reset_counts(const struct device *dev);
+
+// Pixels lit in normal display mode.
+uint32_t mem_display_set_pixels(const struct device *dev);
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2024 The ZMK Contributors
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+
+#include <zmk/activity.h>
+#include <zmk/ble.h>
+#include <zmk/endpoints.h>
+#include <zmk/hid.h>
+#include <zmk/hid_indicators.h>
+#include <zmk/keymap.h>
+#include <zmk/usb.h>
+#include <zmk/wpm.h>
+
+#include "fake_zmk.h"
+
+// on battery, connected to the first BLE profile and typing on the base layer
+struct fake_zmk_state fake_zmk = {
+    .endpoint = {.transport = ZMK_TRANSPORT_BLE, .ble = {.profile_index = 0}},
+    .profile_connected = true,
+    .gauge = {.millivolts = 3900, .state_of_charge = 80, .minutes_to_empty = 600},
+};
+
+struct zmk_endpoint_instance zmk_endpoints_selected() { return fake_zmk.endpoint; }
+
+int zmk_ble_active_profile_index() { return fake_zmk.profile_index; }
+
+bool zmk_ble_active_profile_is_connected() { return fake_zmk.profile_connected; }
+
+bool zmk_ble_active_profile_is_open() { return fake_zmk.profile_open; }
+
+enum zmk_usb_conn_state zmk_usb_get_conn_state() {
+    return fake_zmk.usb_hid_ready ? ZMK_USB_CONN_HID : ZMK_USB_CONN_NONE;
+}
+
+bool zmk_usb_is_powered() { return fake_zmk.usb_hid_ready; }
+
+bool zmk_usb_is_hid_ready() { return fake_zmk.usb_hid_ready; }
+
+// the keymap names no layers, so the layer widget shows the index
+zmk_keymap_layer_index_t zmk_keymap_highest_layer_active() { return fake_zmk.highest_layer; }
+
+const char *zmk_keymap_layer_name(zmk_keymap_layer_id_t layer_id) { return NULL; }
+
+zmk_mod_flags_t zmk_hid_get_explicit_mods() { return fake_zmk.explicit_mods; }
+
+zmk_hid_indicators_t zmk_hid_indicators_get_current_profile() { return fake_zmk.indicators; }
+
+enum zmk_activity_state zmk_activity_get_state() { return ZMK_ACTIVITY_ACTIVE; }
+
+int zmk_wpm_get_state() { return fake_zmk.wpm; }
+
+struct zmk_battery_gauge_state zmk_battery_gauge_get_state() { return fake_zmk.gauge; }